@@ -0,0 +1,165 @@
+#include "animation.h"
+
+static uint16_t readWord(const uint8_t* p) {
+    return pgm_read_byte(p) | (pgm_read_byte(p + 1) << 8);
+}
+
+/*!
+@brief creates a player for an animation made with anim2c. It plays at the top left corner until setPosition().
+@param display
+    the display it draws on.
+@param data
+    the animation stream (the PROGMEM array from anim2c).
+*/
+puroPixel_Animation::puroPixel_Animation(puroPixel_SSD1306* d, const uint8_t* stream) {
+    display = d;
+    data = stream;
+    if (pgm_read_byte(data) != 'P' || pgm_read_byte(data + 1) != 'A') return; // isValid() says false, nothing plays
+    width = pgm_read_byte(data + 2);
+    pages = pgm_read_byte(data + 3);
+    frames = readWord(data + 4);
+    frameTime = readWord(data + 6);
+}
+
+/*!
+@brief tells if the data looked like an animation.
+*/
+bool puroPixel_Animation::isValid() {
+    return frames > 0 && width > 0 && pages > 0;
+}
+
+/*!
+@brief where the animation is drawn. Frames are whole pages, so y is rounded down to a multiple of 8.
+*/
+void puroPixel_Animation::setPosition(int16_t px, int16_t py) {
+    x = px;
+    page0 = py >= 0 ? py / 8 : -((7 - py) / 8);
+}
+
+/*!
+@brief plays again from the first frame after the last one, instead of stopping.
+*/
+void puroPixel_Animation::setLoop(bool l) {
+    loop = l;
+}
+
+/*!
+@brief goes back to the first frame (a key frame), the next nextFrame() draws it.
+*/
+void puroPixel_Animation::rewind() {
+    next = SSD1306_ANIM_HEADER;
+    frame = 0;
+    done = false;
+}
+
+/*!
+@brief decodes the next frame into the buffer and marks only the changed columns dirty, call update() to send them.
+@note   delta frames build on the previous frame, so don't draw over the animation area while it plays (or rewind() after you did).
+@return how many bytes of the buffer changed, 0 when it ended (see isDone()).
+*/
+uint16_t puroPixel_Animation::nextFrame() {
+    if (!isValid() || done) return 0;
+    if (frame >= frames) {
+        if (!loop) {
+            done = true;
+            return 0;
+        }
+        rewind();
+    }
+
+    const uint8_t* p = data + next;
+    uint8_t type = pgm_read_byte(p);
+    uint16_t length = readWord(p + 1);
+    const uint8_t* in = p + 3;
+    const uint8_t* end = in + length;
+    next += 3 + length;
+    frame++;
+
+    unsigned char* buffer = display->getBuffer();
+    uint8_t screenWidth = display->getWidth();
+    int8_t screenPages = display->getHeight() / 8;
+    uint8_t lo[SSD1306_MAX_PAGES];
+    uint8_t hi[SSD1306_MAX_PAGES];
+    for (uint8_t page = 0; page < SSD1306_MAX_PAGES; page++) {
+        lo[page] = screenWidth;
+        hi[page] = 0;
+    }
+
+    uint16_t changed = 0;
+    uint16_t index = 0; // position in the width * pages area
+    uint16_t total = width * pages;
+    while (in < end && index < total) {
+        uint8_t token = pgm_read_byte(in++);
+        uint16_t count = (token & 0x7F) + 1;
+        bool run = token & 0x80;
+        uint8_t value = run ? pgm_read_byte(in++) : 0;
+
+        if (run && value == 0 && type == SSD1306_ANIM_DELTA) {
+            index += count; // nothing changes here
+            continue;
+        }
+        for (uint16_t i = 0; i < count && index < total; i++, index++) {
+            uint8_t b = run ? value : pgm_read_byte(in++);
+            int16_t page = page0 + index / width;
+            int16_t col = x + index % width;
+            if (page < 0 || page >= screenPages || col < 0 || col >= screenWidth) continue;
+
+            unsigned char& dst = buffer[page * screenWidth + col];
+            unsigned char now = type == SSD1306_ANIM_DELTA ? dst ^ b : b;
+            if (now == dst) continue;
+            dst = now;
+            changed++;
+            if (col < lo[page]) lo[page] = col;
+            if (col > hi[page]) hi[page] = col;
+        }
+    }
+    for (int8_t page = 0; page < screenPages; page++) {
+        if (lo[page] <= hi[page]) display->markDirty(lo[page], page * 8, hi[page], page * 8 + 7);
+    }
+    return changed;
+}
+
+/*!
+@brief call it from your loop(): it decodes the next frame once the frame time (set in anim2c) is up. You still call update().
+@return true while the animation is playing.
+*/
+bool puroPixel_Animation::service() {
+    if (!isValid() || done) return false;
+    if (frame > 0 && (uint32_t)(millis() - lastFrame) < frameTime) return true;
+    lastFrame = millis();
+    nextFrame();
+    return !done;
+}
+
+/*!
+@brief true after the last frame when not looping.
+*/
+bool puroPixel_Animation::isDone() {
+    return done;
+}
+
+/*!
+@brief frames played since the start (or rewind()).
+*/
+uint16_t puroPixel_Animation::getFrame() {
+    return frame;
+}
+
+uint16_t puroPixel_Animation::getFrameCount() {
+    return frames;
+}
+
+/*!
+@brief time between frames in milliseconds, as set in anim2c.
+*/
+uint16_t puroPixel_Animation::getFrameTime() {
+    return frameTime;
+}
+
+uint8_t puroPixel_Animation::getWidth() {
+    return width;
+}
+
+uint8_t puroPixel_Animation::getHeight() {
+    return pages * 8;
+}
@@ -0,0 +1,51 @@
+#ifndef SSD1306_ANIMATION_H__
+#define SSD1306_ANIMATION_H__
+
+#include "ssd1306.h"
+
+// Compressed animations (made with examples/host/anim2c) played straight into the frame buffer. Only the bytes a
+// frame changes are written and marked dirty, so update() sends the changed columns and not 1 KiB per frame.
+//
+// Stream layout (little endian, in PROGMEM):
+//   header, 8 bytes: 'P' 'A', width, pages, frame count (16 bit), frame time in ms (16 bit)
+//   frame:           type (0 = key, 1 = delta), payload length (16 bit), payload
+//   payload:         RLE over width * pages bytes in page order (drawPageBitmap order)
+//       0x00-0x7F n: n + 1 literal bytes follow
+//       0x80-0xFF n: the next byte repeated (n & 0x7F) + 1 times
+//   A key frame replaces the area, a delta frame is XORed onto the previous one (a run of 0x00 is a skip).
+
+#define SSD1306_ANIM_HEADER 8
+#define SSD1306_ANIM_KEY    0
+#define SSD1306_ANIM_DELTA  1
+
+class puroPixel_Animation {
+public:
+    puroPixel_Animation(puroPixel_SSD1306* display, const uint8_t* data);
+    bool isValid();
+    void setPosition(int16_t x, int16_t y);
+    void setLoop(bool loop);
+    void rewind();
+    uint16_t nextFrame();
+    bool service();
+    bool isDone();
+    uint16_t getFrame();
+    uint16_t getFrameCount();
+    uint16_t getFrameTime();
+    uint8_t getWidth();
+    uint8_t getHeight();
+private:
+    puroPixel_SSD1306* display;
+    const uint8_t* data;
+    uint8_t width = 0, pages = 0;
+    uint16_t frames = 0;
+    uint16_t frameTime = 0;
+    int16_t x = 0;
+    int16_t page0 = 0;
+    uint32_t next = SSD1306_ANIM_HEADER; // offset of the next frame in data
+    uint16_t frame = 0;                  // frames played since rewind()
+    uint32_t lastFrame = 0;
+    bool loop = false;
+    bool done = false;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "bufops.h"
+#include <string.h>
+
+#if defined(SSD1306_BUFOPS_SSE2)
+#include <emmintrin.h>
+#elif defined(SSD1306_BUFOPS_NEON)
+#include <arm_neon.h>
+#endif
+
+// widest integer the target handles in one load/store
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t word_t;
+#else
+typedef uint32_t word_t;
+#endif
+
+// the buffers are plain byte arrays, memcpy keeps the word loads legal on any alignment
+// and compiles down to a single load/store
+static inline word_t loadWord(const unsigned char* p) {
+    word_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+static inline void storeWord(unsigned char* p, word_t w) {
+    memcpy(p, &w, sizeof(w));
+}
+
+/*!
+@brief sets len bytes to value. The C library memset is already the fastest thing around.
+*/
+void ssd1306_fill(unsigned char* dst, uint8_t value, uint16_t len) {
+    memset(dst, value, len);
+}
+
+/*!
+@brief flips every bit of len bytes.
+*/
+void ssd1306_invert(unsigned char* dst, uint16_t len) {
+#if defined(SSD1306_BUFOPS_SSE2)
+    const __m128i ones = _mm_set1_epi8((char)0xFF);
+    for (; len >= 16; len -= 16, dst += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)dst);
+        _mm_storeu_si128((__m128i*)dst, _mm_xor_si128(v, ones));
+    }
+#elif defined(SSD1306_BUFOPS_NEON)
+    for (; len >= 16; len -= 16, dst += 16) {
+        vst1q_u8(dst, vmvnq_u8(vld1q_u8(dst)));
+    }
+#elif !defined(SSD1306_BUFOPS_SCALAR)
+    for (; len >= sizeof(word_t); len -= sizeof(word_t), dst += sizeof(word_t)) {
+        storeWord(dst, ~loadWord(dst));
+    }
+#endif
+    for (; len > 0; len--, dst++) {
+        *dst = ~*dst;
+    }
+}
+
+/*!
+@brief dst ^= src over len bytes. Handy to toggle a sprite or apply a frame delta.
+*/
+void ssd1306_xor(unsigned char* dst, const unsigned char* src, uint16_t len) {
+#if defined(SSD1306_BUFOPS_SSE2)
+    for (; len >= 16; len -= 16, dst += 16, src += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)dst);
+        __m128i b = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)dst, _mm_xor_si128(a, b));
+    }
+#elif defined(SSD1306_BUFOPS_NEON)
+    for (; len >= 16; len -= 16, dst += 16, src += 16) {
+        vst1q_u8(dst, veorq_u8(vld1q_u8(dst), vld1q_u8(src)));
+    }
+#elif !defined(SSD1306_BUFOPS_SCALAR)
+    for (; len >= sizeof(word_t); len -= sizeof(word_t), dst += sizeof(word_t), src += sizeof(word_t)) {
+        storeWord(dst, loadWord(dst) ^ loadWord(src));
+    }
+#endif
+    for (; len > 0; len--, dst++, src++) {
+        *dst ^= *src;
+    }
+}
+
+/*!
+@brief copies len bytes, the buffers must not overlap.
+*/
+void ssd1306_copy(unsigned char* dst, const unsigned char* src, uint16_t len) {
+    memcpy(dst, src, len);
+}
+
+/*!
+@brief copies a block of cols x pages bytes between two page-ordered buffers (row stride = buffer width).
+*/
+void ssd1306_copyRegion(unsigned char* dst, uint8_t dstWidth, const unsigned char* src, uint8_t srcWidth, uint8_t cols, uint8_t pages) {
+    for (uint8_t page = 0; page < pages; page++) {
+        memcpy(dst, src, cols);
+        dst += dstWidth;
+        src += srcWidth;
+    }
+}
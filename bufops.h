@@ -0,0 +1,23 @@
+#ifndef SSD1306_BUFOPS_H__
+#define SSD1306_BUFOPS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Whole-buffer kernels. They work on 16 bytes at a time with SSE2 (x86) or NEON (ARM), on machine words
+// elsewhere (ESP32, AVR...), and finish the tail byte by byte. Define SSD1306_BUFOPS_SCALAR to force bytes.
+#if !defined(SSD1306_BUFOPS_SCALAR)
+#if defined(__SSE2__)
+#define SSD1306_BUFOPS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SSD1306_BUFOPS_NEON
+#endif
+#endif
+
+void ssd1306_fill(unsigned char* dst, uint8_t value, uint16_t len);
+void ssd1306_invert(unsigned char* dst, uint16_t len);
+void ssd1306_xor(unsigned char* dst, const unsigned char* src, uint16_t len);
+void ssd1306_copy(unsigned char* dst, const unsigned char* src, uint16_t len);
+void ssd1306_copyRegion(unsigned char* dst, uint8_t dstWidth, const unsigned char* src, uint8_t srcWidth, uint8_t cols, uint8_t pages);
+
+#endif
@@ -0,0 +1,127 @@
+#include "console.h"
+#include "font.h"
+
+/*!
+@brief creates a console on a display. Nothing is sent until begin().
+@param display
+    the display, already started with its own begin().
+*/
+puroPixel_Console::puroPixel_Console(puroPixel_SSD1306* d) {
+    display = d;
+    width = d->getWidth();
+    rows = d->getHeight() / 8;
+    if (rows > SSD1306_MAX_PAGES) rows = SSD1306_MAX_PAGES;
+}
+
+/*!
+@brief takes over the panel: clears it and starts writing on the top line.
+*/
+void puroPixel_Console::begin() {
+    clear();
+}
+
+/*!
+@brief gives the panel back: start line to 0 and the next update() resends the whole buffer.
+*/
+void puroPixel_Console::end() {
+    display->setStartLine(0);
+    display->invalidate();
+}
+
+/*!
+@brief clears every line of the console (all 8 RAM pages, the hidden ones too).
+*/
+void puroPixel_Console::clear() {
+    memset(line, 0x00, sizeof(line));
+    for (uint8_t page = 0; page < SSD1306_MAX_PAGES; page++) {
+        display->sendPage(page, line);
+    }
+    display->setStartLine(0);
+    top = 0;
+    used = 1;
+    cursor = 0;
+    sentTo = 0;
+    pageStale = false;
+    scrollPending = false;
+}
+
+/*!
+@brief adds text to the current line. '\n' starts a new one, text that doesn't fit wraps. Only the new characters go to the panel.
+@param text
+    the text.
+*/
+void puroPixel_Console::print(const char* text) {
+    for (; *text; text++) {
+        char character = *text;
+        if (character == '\n') {
+            newLine();
+            continue;
+        }
+        if (character < 0x20 || (uint8_t)character > 0x7F) continue;
+        if (cursor + 6 > width) newLine();
+
+        const char* charF = ASCII[character - 0x20];
+        for (uint8_t cx = 0; cx < 5; cx++) line[cursor + cx] = charF[cx] & 0x7F;
+        line[cursor + 5] = 0x00;
+        cursor += 6;
+    }
+    flushLine(false);
+}
+
+/*!
+@brief adds text and ends the line, like Serial.println().
+@param text
+    the text, empty for just a new line.
+*/
+void puroPixel_Console::println(const char* text) {
+    print(text);
+    newLine();
+}
+
+/*!
+@brief how many text lines fit on the screen.
+*/
+uint8_t puroPixel_Console::getRows() {
+    return rows;
+}
+
+uint8_t puroPixel_Console::currentPage() {
+    return (top + used - 1) % SSD1306_MAX_PAGES;
+}
+
+// sends what changed on the current line, and scrolls once its page is ready. An empty new line waits
+// for its first text (or the next line) so a trailing '\n' doesn't scroll the screen yet.
+void puroPixel_Console::flushLine(bool lineDone) {
+    if (pageStale && (cursor > 0 || lineDone)) {
+        display->sendPage(currentPage(), line); // blank tail included, it wipes the old line
+        pageStale = false;
+        sentTo = cursor;
+    }
+    else if (cursor > sentTo) {
+        display->sendPage(currentPage(), &line[sentTo], sentTo, cursor - sentTo);
+        sentTo = cursor;
+    }
+    else {
+        return;
+    }
+    if (scrollPending) {
+        display->setStartLine(top * 8);
+        scrollPending = false;
+    }
+}
+
+void puroPixel_Console::newLine() {
+    flushLine(true);
+    memset(line, 0x00, sizeof(line));
+    cursor = 0;
+    sentTo = 0;
+    if (used < rows) {
+        used++; // still filling the screen, the page below is blank
+        return;
+    }
+    // screen full: the top page leaves the screen and becomes the new bottom line. Both wait for the
+    // first text of the line, so the panel never shows the old content at the bottom.
+    top = (top + 1) % SSD1306_MAX_PAGES;
+    pageStale = true;
+    scrollPending = true;
+}
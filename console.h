@@ -0,0 +1,35 @@
+#ifndef SSD1306_CONSOLE_H__
+#define SSD1306_CONSOLE_H__
+
+#include "ssd1306.h"
+
+// Log view that scrolls with the display start line. The panel RAM is used as a ring of 8 pages, one text
+// line each: a new line is written into the page that just left the screen and the start line moves 8 rows,
+// so a line costs one page (128 bytes) instead of a full frame. It owns the panel while it runs, the frame
+// buffer is not used.
+class puroPixel_Console {
+public:
+    puroPixel_Console(puroPixel_SSD1306* display);
+    void begin();
+    void end();
+    void clear();
+    void print(const char* text);
+    void println(const char* text = "");
+    uint8_t getRows();
+private:
+    puroPixel_SSD1306* display;
+    uint8_t width;
+    uint8_t rows;          // text lines on screen
+    uint8_t top = 0;       // RAM page on the top row
+    uint8_t used = 1;      // rows in use, the last one is the line being written
+    uint8_t cursor = 0;    // x of the next character
+    uint8_t sentTo = 0;    // columns of the current line already on the panel
+    bool pageStale = false;   // the page still holds a line that scrolled away, send it whole
+    bool scrollPending = false; // move the start line once the new page is written
+    uint8_t line[128];
+    uint8_t currentPage();
+    void flushLine(bool lineDone);
+    void newLine();
+};
+
+#endif
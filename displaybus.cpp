@@ -0,0 +1,181 @@
+#include "displaybus.h"
+
+/*!
+@brief creates the bus manager. Register your displays with add() and call update()/service() on it instead of display.update().
+@param chunk
+    bytes on the bus a display may send before the others get a turn, window commands and control bytes included.
+    Default is one full TwoWire burst of data with its window (SSD1306_WIRE_MAX + 7), at least SSD1306_BUS_MIN_BYTES.
+*/
+puroPixel_DisplayBus::puroPixel_DisplayBus(uint16_t c) {
+    chunk = c < SSD1306_BUS_MIN_BYTES ? SSD1306_BUS_MIN_BYTES : c;
+    statsStart = micros();
+}
+
+/*!
+@brief registers a display. Call begin() on it yourself before, with its mux channel selected.
+@param display
+    the display.
+@param priority
+    higher goes first. A display that keeps waiting gains one step per service() call, so nobody starves.
+@param channel
+    mux channel passed to the setMux() callback, ignored without one.
+@return the id used by the other functions, -1 when SSD1306_BUS_MAX_DISPLAYS are already in.
+*/
+int8_t puroPixel_DisplayBus::add(puroPixel_SSD1306* display, uint8_t priority, uint8_t ch) {
+    if (count >= SSD1306_BUS_MAX_DISPLAYS || display == nullptr) return -1;
+    busSlot& slot = slots[count];
+    slot.display = display;
+    slot.priority = priority;
+    slot.channel = ch;
+    slot.pending = false;
+    slot.served = false;
+    slot.waited = 0;
+    slot.requested = 0;
+    slot.stats = { 0, 0, 0, 0 };
+    return count++;
+}
+
+/*!
+@brief sets the function that switches the mux, it's called only when the next display is on another channel.
+@param select
+    your function, nullptr if there's no mux.
+@param ctx
+    passed back to it as is.
+*/
+void puroPixel_DisplayBus::setMux(busSelectCallback sel, void* ctx) {
+    select = sel;
+    selectCtx = ctx;
+    channel = -1;
+}
+
+/*!
+@brief limits how many bytes one service() call puts on the bus, so it fits your loop() time.
+@param bytes
+    bytes on the bus, window commands and control bytes included. About 1 byte = 22.5 us at 400 kHz.
+    0 (default) = no limit, service() sends everything pending. Smaller values than SSD1306_BUS_MIN_BYTES are raised to it.
+*/
+void puroPixel_DisplayBus::setFrameBudget(uint16_t bytes) {
+    frameBudget = bytes != 0 && bytes < SSD1306_BUS_MIN_BYTES ? SSD1306_BUS_MIN_BYTES : bytes;
+}
+
+/*!
+@brief the display update(): queues what was drawn on it, service() sends it.
+@param id
+    from add().
+*/
+void puroPixel_DisplayBus::update(int8_t id) {
+    if (id < 0 || id >= count) return;
+    busSlot& slot = slots[id];
+    if (!slot.pending) {
+        slot.pending = true;
+        slot.requested = micros(); // latency counts from the oldest change not on the panel yet
+    }
+}
+
+// the pending display with the highest priority (+ its waiting time), ties go round robin
+int8_t puroPixel_DisplayBus::pick() {
+    int8_t best = -1;
+    uint16_t bestRank = 0;
+    for (uint8_t n = 0; n < count; n++) {
+        uint8_t id = (next + n) % count;
+        if (!slots[id].pending) continue;
+        uint16_t rank = slots[id].priority + slots[id].waited;
+        if (best < 0 || rank > bestRank) {
+            best = id;
+            bestRank = rank;
+        }
+    }
+    return best;
+}
+
+/*!
+@brief sends queued changes, one chunk at a time from whoever is most urgent, until nothing is left or the frame budget is used. Call it from your loop().
+@return true while something is still queued.
+*/
+bool puroPixel_DisplayBus::service() {
+    uint32_t start = micros();
+    uint32_t spent = 0;
+    for (uint8_t id = 0; id < count; id++) slots[id].served = false;
+
+    for (;;) {
+        if (frameBudget && spent >= frameBudget) break;
+        int8_t id = pick();
+        if (id < 0) break;
+        busSlot& slot = slots[id];
+
+        if (select && slot.channel != channel) {
+            select(slot.channel, selectCtx);
+            channel = slot.channel;
+        }
+        uint16_t room = chunk;
+        if (frameBudget && frameBudget - spent < room) room = frameBudget - spent;
+        uint16_t sent = slot.display->flushStep(room);
+        if (sent == 0 && slot.display->isDirty()) break; // not even one window fits in what's left of the budget
+        spent += sent;
+        slot.stats.bytes += sent;
+        slot.served = true;
+        next = (id + 1) % count;
+
+        if (!slot.display->isDirty()) {
+            uint32_t latency = micros() - slot.requested;
+            slot.pending = false;
+            slot.waited = 0;
+            slot.stats.frames++;
+            slot.stats.lastLatency = latency;
+            if (latency > slot.stats.maxLatency) slot.stats.maxLatency = latency;
+        }
+    }
+
+    bool pending = false;
+    for (uint8_t id = 0; id < count; id++) {
+        busSlot& slot = slots[id];
+        if (!slot.pending) continue;
+        pending = true;
+        if (slot.served) slot.waited = 0;
+        else if (slot.waited < 255) slot.waited++;
+    }
+    if (spent) busyMicros += micros() - start;
+    return pending;
+}
+
+/*!
+@brief sends everything queued right now, ignoring the frame budget (still chunked and by priority).
+*/
+void puroPixel_DisplayBus::flush() {
+    uint16_t budget = frameBudget;
+    frameBudget = 0;
+    while (service()) {}
+    frameBudget = budget;
+}
+
+/*!
+@brief tells if the last update(id) is not fully on the panel yet.
+*/
+bool puroPixel_DisplayBus::isPending(int8_t id) {
+    if (id < 0 || id >= count) return false;
+    return slots[id].pending;
+}
+
+/*!
+@brief frames, bytes and latency of one display since the last resetStats().
+*/
+busDisplayStats puroPixel_DisplayBus::getStats(int8_t id) {
+    if (id < 0 || id >= count) return { 0, 0, 0, 0 };
+    return slots[id].stats;
+}
+
+/*!
+@brief how much of the time since resetStats() service() spent sending, in percent.
+*/
+uint8_t puroPixel_DisplayBus::getUtilization() {
+    uint32_t elapsed = micros() - statsStart;
+    if (elapsed == 0) return 0;
+    uint32_t busy = busyMicros > elapsed ? elapsed : busyMicros;
+    return (uint64_t)busy * 100 / elapsed;
+}
+
+void puroPixel_DisplayBus::resetStats() {
+    for (uint8_t id = 0; id < count; id++) slots[id].stats = { 0, 0, 0, 0 };
+    busyMicros = 0;
+    statsStart = micros();
+}
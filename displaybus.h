@@ -0,0 +1,63 @@
+#ifndef SSD1306_DISPLAYBUS_H__
+#define SSD1306_DISPLAYBUS_H__
+
+#include "ssd1306.h"
+
+// Several SSD1306 on one TwoWire (0x3C + 0x3D, or behind a mux). Instead of each display sending its whole
+// update() in one go, the bus sends everybody's dirty columns in small chunks, most urgent display first,
+// so a full-screen refresh on one panel doesn't hold back a small change on another one.
+
+// fixed: it sizes the slot array, a sketch overriding it would see another layout than displaybus.cpp
+#define SSD1306_BUS_MAX_DISPLAYS 4
+
+// smallest chunk / frame budget: a column window (9 bytes on I2C for one data byte) plus a few data bytes
+#define SSD1306_BUS_MIN_BYTES 16
+
+// called before talking to a display on another mux channel (TCA9548A and friends)
+typedef void (*busSelectCallback)(uint8_t channel, void* ctx);
+
+struct busDisplayStats {
+    uint32_t frames;      // update() requests that reached the panel
+    uint32_t bytes;       // bytes put on the bus for this display
+    uint32_t lastLatency; // microseconds from update() to the last byte of that frame
+    uint32_t maxLatency;
+};
+
+class puroPixel_DisplayBus {
+public:
+    puroPixel_DisplayBus(uint16_t chunk = SSD1306_WIRE_MAX + 7);
+    int8_t add(puroPixel_SSD1306* display, uint8_t priority = 0, uint8_t channel = 0);
+    void setMux(busSelectCallback select, void* ctx = nullptr);
+    void setFrameBudget(uint16_t bytes);
+    void update(int8_t id);
+    bool service();
+    void flush();
+    bool isPending(int8_t id);
+    busDisplayStats getStats(int8_t id);
+    uint8_t getUtilization();
+    void resetStats();
+private:
+    struct busSlot {
+        puroPixel_SSD1306* display;
+        uint8_t priority;
+        uint8_t channel;
+        bool pending;
+        bool served;     // got bus time in this service()
+        uint8_t waited;  // service() calls it was pending without getting any, added to the priority
+        uint32_t requested;
+        busDisplayStats stats;
+    };
+    busSlot slots[SSD1306_BUS_MAX_DISPLAYS];
+    uint8_t count = 0;
+    uint8_t next = 0; // round robin between displays with the same priority
+    uint16_t chunk;
+    uint16_t frameBudget = 0;
+    busSelectCallback select = nullptr;
+    void* selectCtx = nullptr;
+    int16_t channel = -1; // mux channel selected right now, -1 = unknown
+    uint32_t busyMicros = 0;
+    uint32_t statsStart = 0;
+    int8_t pick();
+};
+
+#endif
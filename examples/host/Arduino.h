@@ -0,0 +1,51 @@
+#ifndef PUROPIXEL_HOST_ARDUINO_H__
+#define PUROPIXEL_HOST_ARDUINO_H__
+
+// Just enough of the Arduino core to build the library on a PC (Linux/macOS), see wire.h for the I2C side.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp your_program.cpp -pthread
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define memcpy_P memcpy
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+// pins only remember their level (the SPI stand-in reads D/C with digitalRead)
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+// Serial goes to stdout
+class HostSerial {
+public:
+    void begin(unsigned long baud);
+    size_t print(const char* str);
+    size_t print(int value, int base = DEC);
+    size_t println(const char* str = "");
+    size_t println(int value, int base = DEC);
+};
+
+extern HostSerial Serial;
+
+#endif
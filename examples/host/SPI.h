@@ -0,0 +1,61 @@
+#ifndef PUROPIXEL_HOST_SPI_H__
+#define PUROPIXEL_HOST_SPI_H__
+
+// Stand-in SPIClass for host builds. Like the TwoWire one nothing is sent: transfers are counted, optionally
+// recorded (with the D/C pin level, so commands and data can be told apart) and timed with a simple clock model.
+
+#include "Arduino.h"
+#include <vector>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) : clock(clock) { (void)bitOrder; (void)dataMode; }
+    uint32_t clock;
+};
+
+struct SPITransfer {
+    bool dc;                    // D/C pin level while the bytes went out (high = data)
+    uint32_t clock;
+    std::vector<uint8_t> bytes;
+};
+
+struct SPIStats {
+    uint32_t transactions; // beginTransaction() ... endTransaction()
+    uint32_t bytes;
+    uint32_t commandBytes; // sent with D/C low
+    uint32_t dataBytes;    // sent with D/C high
+};
+
+class SPIClass {
+public:
+    SPIClass();
+    void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1);
+    void beginTransaction(SPISettings settings);
+    uint8_t transfer(uint8_t data);
+    void writeBytes(const uint8_t* data, uint32_t size);
+    void endTransaction();
+
+    // recorder, dcPin is read at every byte to split commands from data
+    void resetStats();
+    const SPIStats& getStats() const;
+    void setRecording(bool enable, int8_t dcPin);
+    const std::vector<SPITransfer>& getLog() const;
+
+    // bus time: 8 clocks per byte at the transaction's clock + csMicros of CS/D-C setup per transaction
+    double estimateMicros(double csMicros = 0.5) const;
+private:
+    bool fresh; // next bytes start a new log entry
+    bool recording;
+    int8_t dc;
+    SPISettings settings;
+    double clocks; // sum of bytes * 8 / clock, in seconds
+    SPIStats stats;
+    std::vector<SPITransfer> log;
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1 @@
+#include "wire.h"
@@ -0,0 +1,64 @@
+// Turns a list of PBM frames into a compressed animation for puroPixel_Animation (animation.h).
+// Build: g++ -std=gnu++11 -O2 examples/host/anim2c.cpp -o anim2c
+// Usage: ./anim2c [--name NAME] [--ms 40] [--key N] [--invert] frame0.pbm frame1.pbm ... > anim.h
+// All frames must have the same size. --ms is the frame time service() plays at, --key N forces a key frame every N frames.
+
+#include "pbm.h"
+#include "animenc.h"
+
+int main(int argc, char** argv) {
+    const char* name = "animation";
+    int frameMs = 40;
+    int keyEvery = 0;
+    bool invert = false;
+    std::vector<const char*> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--name") && i + 1 < argc) name = argv[++i];
+        else if (!strcmp(argv[i], "--ms") && i + 1 < argc) frameMs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--key") && i + 1 < argc) keyEvery = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--invert")) invert = true;
+        else if (argv[i][0] != '-') inputs.push_back(argv[i]);
+        else inputs.clear(), i = argc;
+    }
+    if (inputs.empty()) {
+        fprintf(stderr, "usage: %s [--name NAME] [--ms 40] [--key N] [--invert] frame0.pbm frame1.pbm ... > anim.h\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t> > frames;
+    int w = 0, h = 0;
+    for (size_t f = 0; f < inputs.size(); f++) {
+        int fw, fh;
+        std::vector<unsigned char> pixels;
+        if (!decodePbm(readFile(inputs[f]), fw, fh, pixels)) {
+            fprintf(stderr, "%s: can't read %s\n", argv[0], inputs[f]);
+            return 1;
+        }
+        if (f == 0) {
+            w = fw;
+            h = fh;
+        }
+        if (fw != w || fh != h || w > 128 || h > 64) {
+            fprintf(stderr, "%s: %s is %dx%d, frames must all be the same size, up to 128x64\n", argv[0], inputs[f], fw, fh);
+            return 1;
+        }
+        frames.push_back(toPages(pixels, w, h, invert));
+    }
+
+    int pages = (h + 7) / 8;
+    size_t keys = 0;
+    std::vector<uint8_t> stream = animEncode(frames, w, pages, frameMs, keyEvery, &keys);
+
+    printf("// '%s', %dx%dpx, %u frames every %d ms. puroPixel_Animation anim(&display, %s);\n", name, w, pages * 8, (unsigned)frames.size(), frameMs, name);
+    printf("const unsigned char %s[] PROGMEM = {", name);
+    for (size_t index = 0; index < stream.size(); index++) {
+        printf("%s%s0x%02x", index ? "," : "", (index % 16) ? " " : "\n    ", stream[index]);
+    }
+    printf("\n};\n");
+
+    size_t raw = frames.size() * w * pages;
+    fprintf(stderr, "%s: %u frames (%u key) %u bytes raw -> %u bytes (%.1f%%)\n", name, (unsigned)frames.size(), (unsigned)keys,
+        (unsigned)raw, (unsigned)stream.size(), 100.0 * stream.size() / raw);
+    return 0;
+}
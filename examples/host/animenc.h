@@ -0,0 +1,72 @@
+#ifndef PUROPIXEL_HOST_ANIMENC_H__
+#define PUROPIXEL_HOST_ANIMENC_H__
+
+// Encoder for the puroPixel_Animation stream (layout in animation.h), shared by anim2c and bench_anim.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// RLE tokens over n bytes. In a delta, zeros are skips, so even a pair of them is worth a run.
+static inline void animRle(const uint8_t* bytes, size_t n, bool delta, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < 128 && bytes[i + run] == bytes[i]) run++;
+        size_t minRun = (delta && bytes[i] == 0) ? 2 : 3;
+        if (run >= minRun) {
+            out.push_back(0x80 | (run - 1));
+            out.push_back(bytes[i]);
+            i += run;
+            continue;
+        }
+
+        // literals up to the next run worth taking
+        size_t start = i;
+        while (i < n && i - start < 128) {
+            size_t ahead = 1;
+            while (i + ahead < n && ahead < 3 && bytes[i + ahead] == bytes[i]) ahead++;
+            if (ahead >= ((delta && bytes[i] == 0) ? 2 : 3)) break;
+            i++;
+        }
+        out.push_back(i - start - 1);
+        out.insert(out.end(), bytes + start, bytes + i);
+    }
+}
+
+static inline void animWord(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+}
+
+// frames: page order, width * pages bytes each. keyEvery > 0 forces a key frame that often (for rewinding
+// mid-way or recovering from drawing over it), otherwise a key is only used when it is smaller than the delta.
+static inline std::vector<uint8_t> animEncode(const std::vector<std::vector<uint8_t> >& frames, uint8_t width, uint8_t pages, uint16_t frameMs, int keyEvery, size_t* keyFrames = nullptr) {
+    std::vector<uint8_t> out = { 'P', 'A', width, pages };
+    animWord(out, frames.size());
+    animWord(out, frameMs);
+
+    size_t size = (size_t)width * pages;
+    size_t keys = 0;
+    for (size_t f = 0; f < frames.size(); f++) {
+        std::vector<uint8_t> key, delta;
+        animRle(frames[f].data(), size, false, key);
+
+        bool useKey = f == 0 || (keyEvery > 0 && f % keyEvery == 0);
+        if (!useKey) {
+            std::vector<uint8_t> diff(size);
+            for (size_t i = 0; i < size; i++) diff[i] = frames[f][i] ^ frames[f - 1][i];
+            animRle(diff.data(), size, true, delta);
+            useKey = key.size() <= delta.size();
+        }
+        const std::vector<uint8_t>& payload = useKey ? key : delta;
+        out.push_back(useKey ? 0 : 1);
+        animWord(out, payload.size());
+        out.insert(out.end(), payload.begin(), payload.end());
+        keys += useKey;
+    }
+    if (keyFrames) *keyFrames = keys;
+    return out;
+}
+
+#endif
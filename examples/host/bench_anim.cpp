@@ -0,0 +1,88 @@
+// Builds a 60 frame 128x64 animation with the library itself, encodes it like anim2c does and compares it with raw
+// frames: flash size, decode speed and bytes on the bus per frame (so the FPS a 400 kHz bus allows).
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/bench_anim.cpp -pthread -o bench_anim
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "animation.h"
+#include "animenc.h"
+#include <chrono>
+
+static const int FRAMES = 60;
+static const uint32_t FREQ = 400000;
+
+// a spinner, a bouncing ball and a counter: the usual boot / alert animation
+static void drawFrame(puroPixel_SSD1306& d, int f) {
+    d.clear();
+    d.drawArc(32, 32, 20, f * 12, f * 12 + 90);
+    d.drawArc(32, 32, 14, -f * 18, -f * 18 + 120);
+    int y = 10 + abs((f % 30) - 15) * 3;
+    d.drawFillCircle(96, y, 6);
+    char text[8];
+    snprintf(text, sizeof(text), "%02d", f);
+    d.drawString(24, 28, text);
+    d.drawString(70, 56, "loading");
+}
+
+static double seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main() {
+    puroPixel_SSD1306 scratch(0x3D, 128, 64, &Wire, true);
+    std::vector<std::vector<uint8_t> > frames;
+    for (int f = 0; f < FRAMES; f++) {
+        drawFrame(scratch, f);
+        frames.push_back(std::vector<uint8_t>(scratch.getBuffer(), scratch.getBuffer() + 1024));
+    }
+    size_t keys;
+    std::vector<uint8_t> stream = animEncode(frames, 128, 8, 40, 0, &keys);
+    printf("flash: raw %u bytes, encoded %u bytes (%.1f%%, %u key frames)\n",
+        FRAMES * 1024, (unsigned)stream.size(), 100.0 * stream.size() / (FRAMES * 1024), (unsigned)keys);
+
+    puroPixel_SSD1306 display(0x3C, 128, 64, &Wire, true);
+    Wire.begin();
+    display.begin();
+    puroPixel_Animation anim(&display, stream.data());
+    anim.setLoop(true);
+
+    // decode only
+    int bad = 0;
+    int decoded = 0;
+    double start = seconds();
+    while (seconds() - start < 0.5) {
+        anim.nextFrame();
+        if (memcmp(display.getBuffer(), frames[(anim.getFrame() - 1) % FRAMES].data(), 1024)) bad++;
+        decoded++;
+    }
+    printf("decode: %.0f frames/s on this machine\n", decoded / (seconds() - start));
+
+    // bus: raw frames with drawPageBitmap + update() against the decoder + update()
+    display.clear();
+    display.update();
+    Wire.resetStats();
+    for (int f = 0; f < FRAMES; f++) {
+        display.drawPageBitmap(0, 0, frames[f].data(), 128, 64, BLIT_OPAQUE);
+        display.update();
+    }
+    double rawMicros = Wire.estimateMicros(FREQ) / FRAMES;
+    uint32_t rawBytes = Wire.getStats().bytes / FRAMES;
+
+    anim.rewind();
+    display.clear();
+    display.update();
+    Wire.resetStats();
+    for (int f = 0; f < FRAMES; f++) {
+        anim.nextFrame();
+        display.update();
+        if (memcmp(display.getBuffer(), frames[f].data(), 1024)) bad++;
+    }
+    double animMicros = Wire.estimateMicros(FREQ) / FRAMES;
+    uint32_t animBytes = Wire.getStats().bytes / FRAMES;
+
+    printf("bus @400k: raw frames %u bytes/frame (%.0f fps max), animation %u bytes/frame (%.0f fps max)\n",
+        rawBytes, 1e6 / rawMicros, animBytes, 1e6 / animMicros);
+    if (bad) printf("%d frames decoded wrong\n", bad);
+    return bad != 0;
+}
@@ -0,0 +1,70 @@
+// Buffer kernels (bufops.h) against the plain byte loops they replaced, for 128x64 and 128x32 buffers.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/bench_bufops.cpp -pthread -o bench_bufops
+// Add -DSSD1306_BUFOPS_SCALAR to see the byte-only fallback, or -mno-sse2 on x86 for the word path.
+
+#include "Arduino.h"
+#include "bufops.h"
+#include <chrono>
+
+static unsigned char bufA[1024];
+static unsigned char bufB[1024];
+
+static void byteInvert(unsigned char* dst, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) dst[i] = ~dst[i];
+}
+
+static void byteXor(unsigned char* dst, const unsigned char* src, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) dst[i] ^= src[i];
+}
+
+static void byteFill(unsigned char* dst, uint8_t value, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) dst[i] = value;
+}
+
+template<typename F>
+static double timeNs(F run) {
+    const uint32_t iterations = 200000;
+    double best = 0;
+    for (int round = 0; round < 5; round++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            run(i);
+            __asm__ __volatile__("" : : "r"(bufA), "r"(bufB) : "memory"); // keep the loops from being merged or dropped
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+        if (round == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+static void row(const char* name, uint16_t len, double bytesNs, double kernelNs) {
+    printf("%-8s %5u B %10.1f ns %10.1f ns %7.1fx\n", name, len, bytesNs, kernelNs, bytesNs / kernelNs);
+}
+
+int main() {
+#if defined(SSD1306_BUFOPS_SSE2)
+    const char* path = "SSE2";
+#elif defined(SSD1306_BUFOPS_NEON)
+    const char* path = "NEON";
+#elif defined(SSD1306_BUFOPS_SCALAR)
+    const char* path = "scalar";
+#else
+    const char* path = "word";
+#endif
+    printf("kernel path: %s\n%-8s %7s %13s %13s %8s\n", path, "op", "size", "byte loop", "kernel", "gain");
+
+    const uint16_t sizes[] = { 1024, 512 }; // 128x64, 128x32
+    for (uint8_t s = 0; s < 2; s++) {
+        uint16_t len = sizes[s];
+        row("fill", len,
+            timeNs([len](uint32_t i) { byteFill(bufA, i, len); }),
+            timeNs([len](uint32_t i) { ssd1306_fill(bufA, i, len); }));
+        row("invert", len,
+            timeNs([len](uint32_t) { byteInvert(bufA, len); }),
+            timeNs([len](uint32_t) { ssd1306_invert(bufA, len); }));
+        row("xor", len,
+            timeNs([len](uint32_t) { byteXor(bufA, bufB, len); }),
+            timeNs([len](uint32_t) { ssd1306_xor(bufA, bufB, len); }));
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Micro-benchmarks for the drawing primitives, host only (nothing goes to the bus). Text cases also report glyphs/s.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/bench_primitives.cpp -pthread -o bench_primitives
+// Usage: ./bench_primitives [--json] [--time ms] [--filter text]
+// --json prints one object per run, so two versions of the library can be diffed.
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "terminal.h"
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+struct Bench {
+    const char* name;
+    uint32_t pixels; // pixels one call touches, for pixels/s
+    uint32_t glyphs; // characters one call draws, for glyphs/s (0 if not text)
+    void (*run)(puroPixel_SSD1306& display, uint32_t i);
+};
+
+static const char* benchText = "Hello, SSD1306!"; // 15 chars
+
+// the terminal keeps its grid between calls, it's bound to the one display main() passes in
+static puroPixel_Terminal& benchTerminal(puroPixel_SSD1306& display) {
+    static puroPixel_Terminal terminal(&display);
+    return terminal;
+}
+
+static const Bench benches[] = {
+    { "drawPixel", 1, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawPixel((i * 7) & 127, (i * 13) & 63, i & 1); } },
+    { "drawHorLine/64", 64, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawHorLine(i & 127, 0, 64, i & 1); } },
+    { "drawHorLine/13", 13, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawHorLine(i & 127, 5 + (i & 31), 13, i & 1); } },
+    { "drawVerLine/128", 128, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawVerLine(0, i & 63, 128, i & 1); } },
+    { "drawVerLine/21", 21, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawVerLine(3 + (i & 63), i & 63, 21, i & 1); } },
+    { "drawRect/100x50", 300, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawRect(10, 5, 100, 50, i & 1); } },
+    { "drawFillRect/100x50", 5000, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawFillRect(10, 5, 100, 50, i & 1); } },
+    { "drawFillRect/13x11", 143, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawFillRect(i & 63, 3 + (i & 31), 13, 11, i & 1); } },
+    { "drawString/s1", 15 * 48, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(0, i & 31, benchText, 1, i & 1, false, true); } },
+    { "drawString/s2", 15 * 48 * 4, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(0, i & 31, benchText, 2, i & 1, false, true); } },
+    { "drawString/s3", 15 * 48 * 9, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(0, i & 31, benchText, 3, i & 1, false, true); } },
+    { "drawString/s4", 15 * 48 * 16, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(0, i & 31, benchText, 4, i & 1, false, true); } },
+    { "drawString/s1/bg", 15 * 48, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(1, 1 + (i & 31), benchText, 1, i & 1, true, true); } },
+    { "drawString/s2/bg", 15 * 48 * 4, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(2, 2 + (i & 31), benchText, 2, i & 1, true, true); } },
+    { "drawString/s3/bg", 15 * 48 * 9, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(3, 3 + (i & 31), benchText, 3, i & 1, true, true); } },
+    { "drawString/s4/bg", 15 * 48 * 16, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.drawString(4, 4 + (i & 31), benchText, 4, i & 1, true, true); } },
+    { "measureString/s2", 0, 15, [](puroPixel_SSD1306& d, uint32_t) { volatile stringSize s = d.measureString(benchText, 2); (void)s; } },
+    { "drawStringCached/same", 15 * 48, 15, [](puroPixel_SSD1306& d, uint32_t) { static textRun run = {}; d.drawStringCached(run, 0, 8, benchText); } },
+    { "drawBitmap/128x64", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawBitmap(0, 0, epd_bitmap_splash_puro_pixel, 128, 64, i & 1); } },
+    { "drawPageBitmap/opaque", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t) { d.drawPageBitmap(0, 0, epd_pages_splash_puro_pixel, 128, 64, BLIT_OPAQUE); } },
+    { "drawPageBitmap/y+3", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawPageBitmap(0, 3, epd_pages_splash_puro_pixel, 128, 64, BLIT_TRANSPARENT, i & 1); } },
+    { "drawPageBitmap/xor", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawPageBitmap(0, i & 7, epd_pages_splash_puro_pixel, 128, 64, BLIT_XOR); } },
+    { "drawCircle/r30", 188, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawCircle(64, 32, 30, 1, i & 1); } },
+    { "drawFillCircle/r30", 2827, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawFillCircle(64, 32, 30, i & 1); } },
+    { "drawEllipse/60x28", 180, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawEllipse(64, 32, 60, 28, i & 1); } },
+    { "drawFillEllipse/60x28", 5278, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawFillEllipse(64, 32, 60, 28, i & 1); } },
+    { "drawArc/r30/270", 141, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawArc(64, 32, 30, 135, 405, i & 1); } },
+    { "drawRoundRect/100x50", 290, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawRoundRect(10, 5, 100, 50, 8, i & 1); } },
+    { "drawFillRoundRect/100x50", 4945, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.drawFillRoundRect(10, 5, 100, 50, 8, i & 1); } },
+    { "drawCircle/r30/in clip", 188, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.pushClip(24, 0, 80, 64); d.drawCircle(40, 32, 30, 1, i & 1); d.popClip(); } },
+    { "drawCircle/r30/cut by clip", 94, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.pushClip(0, 0, 64, 64); d.drawCircle(64, 32, 30, 1, i & 1); d.popClip(); } },
+    { "drawString/s2/clip", 15 * 48 * 4, 15, [](puroPixel_SSD1306& d, uint32_t i) { d.pushClip(8, 8, 100, 40); d.drawString(0, i & 31, benchText, 2, i & 1, false, true); d.popClip(); } },
+    { "terminal/1 cell", 48, 1, [](puroPixel_SSD1306& d, uint32_t i) { char s[2] = { (char)('0' + (i & 7)), 0 }; benchTerminal(d).putAt(i % 21, (i >> 3) & 7, s); benchTerminal(d).render(); } },
+    { "terminal/21x8 rewrite", 168 * 48, 168, [](puroPixel_SSD1306& d, uint32_t i) {
+        puroPixel_Terminal& t = benchTerminal(d);
+        t.setCursor(0, 0);
+        for (int row = 0; row < 8; row++) t.printf("%-20d%c", (int)(i + row), row < 7 ? '\n' : ' ');
+        t.render();
+    } },
+    { "clear+drawString/21x8", 168 * 48, 168, [](puroPixel_SSD1306& d, uint32_t i) {
+        d.clear();
+        char line[22];
+        for (int row = 0; row < 8; row++) {
+            snprintf(line, sizeof(line), "%-21d", (int)(i + row));
+            d.drawString(0, row * 8, line, 1, 1, false, false);
+        }
+    } },
+    { "fillScreen", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t i) { d.fillScreen(i & 1); } },
+    { "clear", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t) { d.clear(); } },
+    { "invert", 128 * 64, 0, [](puroPixel_SSD1306& d, uint32_t) { d.invert(); } },
+};
+
+static double nowNs() {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// runs the bench in growing batches until one batch takes at least minNs, then keeps the best of 5 batches
+static double measure(const Bench& bench, puroPixel_SSD1306& display, double minNs, uint32_t& iterations) {
+    iterations = 1;
+    for (;;) {
+        double start = nowNs();
+        for (uint32_t i = 0; i < iterations; i++) bench.run(display, i);
+        if (nowNs() - start >= minNs || iterations >= (1u << 30)) break;
+        iterations *= 2;
+    }
+
+    double best = 0;
+    for (int round = 0; round < 5; round++) {
+        double start = nowNs();
+        for (uint32_t i = 0; i < iterations; i++) bench.run(display, i);
+        double elapsed = (nowNs() - start) / iterations;
+        if (round == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    double minNs = 50e6;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--json")) json = true;
+        else if (!strcmp(argv[i], "--time") && i + 1 < argc) minNs = atof(argv[++i]) * 1e6;
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--json] [--time ms] [--filter text]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    puroPixel_SSD1306 display(0x3C, 128, 64, &Wire, true);
+    display.clear();
+
+    if (json) printf("{\n  \"display\": \"128x64\",\n  \"results\": [");
+    else printf("%-22s %12s %16s %12s %12s\n", "primitive", "ns/op", "pixels/s", "glyphs/s", "iterations");
+
+    bool first = true;
+    for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+        const Bench& bench = benches[b];
+        if (filter != nullptr && strstr(bench.name, filter) == nullptr) continue;
+
+        uint32_t iterations;
+        double ns = measure(bench, display, minNs, iterations);
+        double pixelsPerSecond = bench.pixels * 1e9 / ns;
+        double glyphsPerSecond = bench.glyphs * 1e9 / ns;
+
+        if (json) {
+            printf("%s\n    { \"name\": \"%s\", \"ns_per_op\": %.2f, \"pixels_per_s\": %.0f, \"glyphs_per_s\": %.0f, \"iterations\": %u }",
+                first ? "" : ",", bench.name, ns, pixelsPerSecond, glyphsPerSecond, iterations);
+        }
+        else {
+            printf("%-22s %12.1f %16.0f %12.0f %12u\n", bench.name, ns, pixelsPerSecond, glyphsPerSecond, iterations);
+        }
+        first = false;
+    }
+    if (json) printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Prints what begin(), update() and the scroll commands cost on the bus, at 100 kHz, 400 kHz and 1 MHz,
+// and the same frames over 4-wire SPI at 8 MHz.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/bus_cost.cpp -pthread -o bus_cost
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "SPI.h"
+#include "ssd1306.h"
+#include "console.h"
+
+static void report(const char* name) {
+    const WireStats& s = Wire.getStats();
+    printf("%-24s %6u txn %6u bytes (%5u cmd %5u data)  %9.1f us @100k %8.1f us @400k %8.1f us @1M\n",
+        name, s.transactions, s.bytes, s.commandBytes, s.dataBytes,
+        Wire.estimateMicros(100000), Wire.estimateMicros(400000), Wire.estimateMicros(1000000));
+    Wire.resetStats();
+}
+
+static void reportSPI(const char* name) {
+    const SPIStats& s = SPI.getStats();
+    printf("%-24s %6u txn %6u bytes (%5u cmd %5u data)  %9.1f us @8M\n",
+        name, s.transactions, s.bytes, s.commandBytes, s.dataBytes, SPI.estimateMicros());
+    SPI.resetStats();
+}
+
+int main() {
+    puroPixel_SSD1306 display(0x3C, 128, 64, &Wire, true);
+    Wire.begin();
+
+    Wire.resetStats();
+    display.begin();
+    report("begin()");
+
+    display.fillScreen(1);
+    display.update();
+    report("update() full frame");
+
+    display.drawString(0, 0, "7");
+    display.update();
+    report("update() one glyph");
+
+    display.update();
+    report("update() nothing drawn");
+
+    // a 2 page ticker moving one column: redrawn vs content scroll
+    display.drawString(-1, 0, "Ticker text, scale 2", 2, 1, true, false);
+    display.update();
+    report("update() 2 page ticker");
+
+    const uint8_t column[2] = { 0x3C, 0x00 };
+    display.scrollContent(0, 1, column);
+    report("scrollContent() 2 pages");
+
+    display.startScroll(SCROLL_LEFT, 0, 7, SPEED_2_FRAMES);
+    report("startScroll()");
+
+    display.stopScroll(false);
+    report("stopScroll(false)");
+
+    display.setContrast(0x40);
+    report("setContrast()");
+
+    // log view: a full screen of lines first, then one more scrolls the start line
+    puroPixel_Console console(&display);
+    console.begin();
+    for (int i = 0; i < 12; i++) console.println("boot: sensor 3 ok");
+    Wire.resetStats();
+    console.println("heap 81234 free");
+    report("console println()");
+    console.end();
+    bool overflow = Wire.getStats().overflows != 0;
+
+    // same panel on SPI: no control bytes, no address, and the clock is 20x the fast mode I2C one
+    printf("\n4-wire SPI\n");
+    puroPixel_SPITransport spi(&SPI, 4, 5, 6);
+    puroPixel_SSD1306 spiDisplay(&spi, 128, 64, true);
+    SPI.begin();
+    SPI.setRecording(true, 4);
+    SPI.resetStats();
+    spiDisplay.begin();
+    reportSPI("begin()");
+
+    spiDisplay.fillScreen(1);
+    spiDisplay.update();
+    reportSPI("update() full frame");
+
+    spiDisplay.drawString(0, 0, "7");
+    spiDisplay.update();
+    reportSPI("update() one glyph");
+
+    return overflow;
+}
@@ -0,0 +1,143 @@
+#ifndef PUROPIXEL_HOST_CAPTURE_H__
+#define PUROPIXEL_HOST_CAPTURE_H__
+
+// Frame capture for headless runs, on top of setFrameCapture(): the last frames in memory, an append-only frame
+// stream file, PBM export and comparison against golden PBM images. The UI code itself doesn't change.
+
+#include "ssd1306.h"
+#include "pbm.h"
+
+// a frame in page order (bit 0 on top) to a binary PBM (P4), 1 = lit
+static inline std::vector<unsigned char> pagesToPbm(const unsigned char* pages, int w, int h) {
+    char header[32];
+    int length = snprintf(header, sizeof(header), "P4\n%d %d\n", w, h);
+    std::vector<unsigned char> out(header, header + length);
+    int rowBytes = (w + 7) / 8;
+    size_t start = out.size();
+    out.resize(start + (size_t)rowBytes * h, 0);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if ((pages[(y / 8) * w + x] >> (y & 7)) & 1) out[start + y * rowBytes + x / 8] |= 0x80 >> (x & 7);
+        }
+    }
+    return out;
+}
+
+static inline bool writeFile(const char* path, const std::vector<unsigned char>& data) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+}
+
+// pixels that differ between a page order frame and a golden PBM, -1 when the golden can't be read or has another
+// size. diffPath (optional) gets a PBM with only the different pixels lit.
+static inline long compareGolden(const unsigned char* pages, int w, int h, const char* goldenPath, const char* diffPath = nullptr) {
+    int gw, gh;
+    std::vector<unsigned char> golden;
+    if (!decodePbm(readFile(goldenPath), gw, gh, golden) || gw != w || gh != h) return -1;
+
+    std::vector<unsigned char> diff(w * h, 0);
+    long count = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            bool lit = (pages[(y / 8) * w + x] >> (y & 7)) & 1;
+            if (lit != (golden[y * w + x] != 0)) {
+                diff[y * w + x] = 1;
+                count++;
+            }
+        }
+    }
+    if (diffPath != nullptr && count > 0) {
+        std::vector<unsigned char> diffPages = toPages(diff, w, h, false);
+        writeFile(diffPath, pagesToPbm(diffPages.data(), w, h));
+    }
+    return count;
+}
+
+class puroPixel_Capture {
+public:
+    // ringSize: how many of the last frames stay in memory (0 = none, for stream-only recording)
+    puroPixel_Capture(size_t ringSize = 64) : ring(ringSize) {}
+    ~puroPixel_Capture() { closeStream(); }
+
+    // headless (default): the display never touches the bus, update() only lands here
+    void attach(puroPixel_SSD1306& display, bool headless = true) {
+        display.setFrameCapture(onFrame, this, headless);
+    }
+
+    // appends every frame to path as a P4 image. Concatenated PBMs are a valid netpbm stream, so the file opens
+    // in image tools as is, and readFrame() gets frame n back.
+    bool openStream(const char* path) {
+        closeStream();
+        stream = fopen(path, "wb");
+        return stream != nullptr;
+    }
+
+    void closeStream() {
+        if (stream != nullptr) fclose(stream);
+        stream = nullptr;
+    }
+
+    uint32_t getCount() const { return count; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // back = 0 is the last frame, 1 the one before... Empty when it already left the ring.
+    const std::vector<unsigned char>& getFrame(size_t back = 0) const {
+        static const std::vector<unsigned char> none;
+        if (ring.empty() || back >= ring.size() || back >= count) return none;
+        return ring[(count - 1 - back) % ring.size()];
+    }
+
+    bool savePbm(const char* path, size_t back = 0) const {
+        const std::vector<unsigned char>& frame = getFrame(back);
+        return !frame.empty() && writeFile(path, pagesToPbm(frame.data(), width, height));
+    }
+
+    long compare(const char* goldenPath, const char* diffPath = nullptr, size_t back = 0) const {
+        const std::vector<unsigned char>& frame = getFrame(back);
+        if (frame.empty()) return -1;
+        return compareGolden(frame.data(), width, height, goldenPath, diffPath);
+    }
+
+    // frame n of a stream file written by openStream(), back in page order
+    static bool readFrame(const char* path, uint32_t n, std::vector<unsigned char>& pages, int& w, int& h) {
+        std::vector<unsigned char> data = readFile(path);
+        size_t pos = 0;
+        for (uint32_t i = 0; pos < data.size(); i++) {
+            size_t header = pos + 2;
+            if (data[pos] != 'P' || !headerNumber(data, header, w) || !headerNumber(data, header, h)) return false;
+            size_t end = header + 1 + (size_t)((w + 7) / 8) * h;
+            if (end > data.size()) return false;
+            if (i == n) {
+                std::vector<unsigned char> pixels;
+                if (!decodePbm(std::vector<unsigned char>(data.begin() + pos, data.begin() + end), w, h, pixels)) return false;
+                pages = toPages(pixels, w, h, false);
+                return true;
+            }
+            pos = end;
+        }
+        return false;
+    }
+private:
+    std::vector<std::vector<unsigned char> > ring;
+    uint32_t count = 0;
+    int width = 0, height = 0;
+    FILE* stream = nullptr;
+
+    static void onFrame(const unsigned char* buffer, uint8_t w, uint8_t h, void* ctx) {
+        puroPixel_Capture* self = (puroPixel_Capture*)ctx;
+        self->width = w;
+        self->height = h;
+        size_t size = (size_t)w * (h / 8);
+        if (!self->ring.empty()) self->ring[self->count % self->ring.size()].assign(buffer, buffer + size);
+        if (self->stream != nullptr) {
+            std::vector<unsigned char> pbm = pagesToPbm(buffer, w, h);
+            fwrite(pbm.data(), 1, pbm.size(), self->stream);
+        }
+        self->count++;
+    }
+};
+
+#endif
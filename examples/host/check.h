@@ -0,0 +1,53 @@
+#ifndef PUROPIXEL_HOST_CHECK_H__
+#define PUROPIXEL_HOST_CHECK_H__
+
+// Helpers shared by the host checks (check_*.cpp): a seeded random source, so a failure shows up again on the next
+// run, and a failure counter. Each check prints what failed and returns the count from main(), 0 when all is fine.
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdint.h>
+
+static uint32_t checkSeed = 1;
+static int checkFailures = 0;
+
+// random int in [lo, hi]
+static inline int checkRandom(int lo, int hi) {
+    checkSeed = checkSeed * 1103515245u + 12345u;
+    return lo + (int)((checkSeed >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+static inline bool checkThat(bool ok, const char* format, ...) {
+    if (ok) return true;
+    va_list args;
+    va_start(args, format);
+    printf("FAIL: ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    checkFailures++;
+    return false;
+}
+
+static inline bool checkSame(const unsigned char* a, const unsigned char* b, size_t len, const char* format, ...) {
+    if (memcmp(a, b, len) == 0) return true;
+    size_t at = 0;
+    while (a[at] == b[at]) at++;
+    va_list args;
+    va_start(args, format);
+    printf("FAIL: ");
+    vprintf(format, args);
+    printf(" (first difference at byte %u: %02X vs %02X)\n", (unsigned)at, a[at], b[at]);
+    va_end(args);
+    checkFailures++;
+    return false;
+}
+
+static inline int checkDone(const char* name) {
+    if (checkFailures == 0) printf("%s: ok\n", name);
+    else printf("%s: %d failed\n", name, checkFailures);
+    return checkFailures;
+}
+
+#endif
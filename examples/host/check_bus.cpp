@@ -0,0 +1,129 @@
+// Three panels of different sizes on one TwoWire behind puroPixel_DisplayBus. The recorded Wire traffic is played,
+// address by address, into mocktransport.h models, and has to match every buffer after random draws, frame budgets
+// and shadow settings. Also checks that a service() never goes over its budget, that the mux callback runs only
+// on a channel change, and that frames sent in steps are captured (and counted, with -DSSD1306_ENABLE_STATS) once.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_bus.cpp -pthread -o check_bus
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "displaybus.h"
+#include "mocktransport.h"
+#include "check.h"
+
+struct busPanel {
+    uint8_t address, channel;
+    puroPixel_MockTransport* model;
+};
+
+static busPanel panels[3];
+static int selectedChannel = -1;
+static uint32_t selects = 0;
+
+// the recorded transactions so far into the models, then a fresh log. Each one has to be for a panel on the
+// channel the mux callback picked last.
+static void replay() {
+    for (const WireTransaction& transaction : Wire.getLog()) {
+        busPanel* panel = nullptr;
+        for (busPanel& candidate : panels) {
+            if (candidate.address == transaction.address && candidate.channel == selectedChannel) panel = &candidate;
+        }
+        if (!checkThat(panel != nullptr, "transaction for 0x%02X, no such panel on channel %d", transaction.address, selectedChannel)) break;
+        const uint8_t* payload = transaction.bytes.data() + 1;
+        uint16_t length = transaction.bytes.size() - 1;
+        if (transaction.bytes[0] == SSD1306_CONTROL_DATA) panel->model->data(payload, length);
+        else panel->model->commands(payload, length);
+    }
+    Wire.resetStats();
+}
+
+static void selectChannel(uint8_t channel, void*) {
+    replay(); // what went out before belongs to the previous channel
+    checkThat(channel != selectedChannel, "mux callback without a channel change");
+    selectedChannel = channel;
+    selects++;
+}
+
+static uint32_t busBytes(puroPixel_SSD1306** displays) {
+    return displays[0]->getTransport()->getBytes() + displays[1]->getTransport()->getBytes() + displays[2]->getTransport()->getBytes();
+}
+
+static void checkTraffic() {
+    puroPixel_SSD1306 a(0x3C, 128, 64, &Wire, true), b(0x3D, 128, 32, &Wire, true), c(0x3C, 64, 48, &Wire, true);
+    puroPixel_MockTransport modelA(128, 64), modelB(128, 32), modelC(64, 48);
+    panels[0] = { 0x3C, 0, &modelA };
+    panels[1] = { 0x3D, 0, &modelB };
+    panels[2] = { 0x3C, 1, &modelC }; // same address, behind the mux
+    puroPixel_SSD1306* displays[3] = { &a, &b, &c };
+
+    Wire.begin();
+    Wire.setRecording(true);
+    puroPixel_DisplayBus bus(17);
+    bus.setMux(selectChannel);
+    int8_t ids[3] = { bus.add(&a, 0, 0), bus.add(&b, 3, 0), bus.add(&c, 1, 1) };
+    for (int k = 0; k < 3; k++) {
+        selectedChannel = panels[k].channel; // begin() goes around the bus
+        displays[k]->begin();
+        replay();
+    }
+    selectedChannel = -1;
+
+    for (int op = 0; op < 30000; op++) {
+        int k = checkRandom(0, 2);
+        puroPixel_SSD1306& display = *displays[k];
+        switch (checkRandom(0, 6)) {
+        case 0: display.drawFillRect(checkRandom(-6, 134), checkRandom(-3, 67), checkRandom(0, 50), checkRandom(0, 30), checkRandom(0, 1)); break;
+        case 1: display.drawString(checkRandom(0, 127), checkRandom(0, 63), "ab", checkRandom(1, 3), checkRandom(0, 1), checkRandom(0, 1)); break;
+        case 2: if (checkRandom(0, 10) == 0) display.fillScreen(checkRandom(0, 1)); break;
+        case 3: if (checkRandom(0, 50) == 0) display.enableShadow(checkRandom(0, 1), checkRandom(0, 10)); break;
+        case 4: bus.update(ids[k]); break;
+        default: {
+            uint16_t budget = checkRandom(0, 300);
+            bus.setFrameBudget(budget);
+            uint32_t before = busBytes(displays);
+            bus.service();
+            uint32_t used = busBytes(displays) - before;
+            uint16_t limit = budget == 0 ? 0 : budget < SSD1306_BUS_MIN_BYTES ? SSD1306_BUS_MIN_BYTES : budget;
+            checkThat(limit == 0 || used <= limit, "op %d: service() sent %u bytes with a budget of %u", op, used, budget);
+            break;
+        }
+        }
+    }
+    for (int k = 0; k < 3; k++) bus.update(ids[k]);
+    bus.flush();
+    replay();
+    for (int k = 0; k < 3; k++) {
+        checkSame(panels[k].model->getMemory().data(), displays[k]->getBuffer(), displays[k]->getWidth() * displays[k]->getHeight() / 8,
+            "panel %d after flush()", k);
+    }
+    checkThat(selects > 3, "the mux callback never ran");
+}
+
+static int captures = 0;
+
+static void checkSteppedFrames() {
+    puroPixel_MockTransport panel;
+    puroPixel_SSD1306 display(&panel, 128, 64, true);
+    display.begin();
+    display.setFrameCapture([](const unsigned char*, uint8_t, uint8_t, void*) { captures++; });
+    display.resetStats();
+    display.invalidate();
+    uint32_t steps = 0;
+    while (display.flushStep(100) > 0) steps++;
+    checkThat(steps > 1 && captures == 1, "a frame in %u steps captured %d times", steps, captures);
+#ifdef SSD1306_ENABLE_STATS
+    checkThat(display.getStats().frames == 1 && display.getStats().dirtyBytes == 1024, "a frame in steps counted %u times, %u dirty bytes",
+        display.getStats().frames, display.getStats().dirtyBytes);
+#endif
+    display.drawPixel(3, 3);
+    display.update();
+    checkThat(captures == 2, "update() after stepped frames captured %d times", captures - 1);
+    display.drawPixel(4, 4);
+    checkThat(display.flushStep(5) == 0 && display.isDirty(), "flushStep() sent with a budget smaller than one window");
+}
+
+int main() {
+    checkTraffic();
+    checkSteppedFrames();
+    return checkDone("check_bus");
+}
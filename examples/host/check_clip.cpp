@@ -0,0 +1,110 @@
+// Checks the clip stack: random primitives under 0 to 2 nested pushClip() calls (with and without moving the origin)
+// have to change exactly what the same primitive drawn without a clip changes inside the clip rectangle, and
+// nothing outside it. update() is replayed into mocktransport.h, so a clipped area that isn't marked dirty shows up,
+// and getPixel() is read through the origin. Runs on 128x64, 96x16 and 64x48.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_clip.cpp -pthread -o check_clip
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "mocktransport.h"
+#include "check.h"
+#include <algorithm>
+#include <vector>
+
+static void drawRandom(puroPixel_SSD1306& display, int kind, int x, int y, int a, int b, int color, int r) {
+    static const char* texts[] = { "Hi", "Hello, SSD1306!", "a\nb c", "~}|{" };
+    switch (kind) {
+    case 0: display.drawPixel(x, y, color); break;
+    case 1: display.drawHorLine(x, y, a, color); break;
+    case 2: display.drawVerLine(x, y, a, color); break;
+    case 3: display.drawRect(x, y, a, b, color); break;
+    case 4: display.drawFillRect(x, y, a, b, color); break;
+    case 5: display.drawString(x, y, texts[r % 4], 1 + r % 6, color, r % 3 == 0, false); break;
+    case 6: display.drawBitmap(x, y, epd_bitmap_splash_puro_pixel + r % 64, a + 8, b + 8, color); break;
+    case 7: display.drawFillCircle(x, y, r % 20, color); break;
+    case 8: display.drawCircle(x, y, r % 30, 0, color); break;
+    case 9:
+        if (r % 2) display.drawEllipse(x, y, r % 30, a % 20 + 1, color);
+        else display.drawFillEllipse(x, y, r % 30, a % 20 + 1, color);
+        break;
+    case 10: display.drawArc(x, y, r % 30, a * 7, b * 11, color); break;
+    case 11:
+        if (r % 2) display.drawRoundRect(x, y, a, b, r % 12, color);
+        else display.drawFillRoundRect(x, y, a, b, r % 12, color);
+        break;
+    case 12: display.drawPageBitmap(x, y, epd_bitmap_splash_puro_pixel + r % 64, 1 + a % 60, 1 + b % 40, (BlitMode)(r % 3), color); break;
+    }
+}
+
+static bool bit(const unsigned char* buffer, int w, int x, int y) {
+    return (buffer[x + (y / 8) * w] >> (y & 7)) & 1;
+}
+
+static void checkGeometry(uint8_t w, uint8_t h) {
+    puroPixel_MockTransport panel(w, h);
+    puroPixel_SSD1306 display(&panel, w, h, true);
+    puroPixel_SSD1306 unclipped(nullptr, w, h, true);
+    display.begin();
+    size_t size = w * h / 8;
+    std::vector<unsigned char> before(size);
+
+    for (int op = 0; op < 20000; op++) {
+        // the clip and origin the display should end up with, in screen coordinates
+        display.resetClip();
+        int originX = 0, originY = 0, clipX0 = 0, clipY0 = 0, clipX1 = w - 1, clipY1 = h - 1;
+        int depth = checkRandom(0, 2);
+        for (int level = 0; level < depth; level++) {
+            int x = checkRandom(-10, w + 10), y = checkRandom(-10, h + 10), cw = checkRandom(0, 80), ch = checkRandom(0, 50);
+            bool moveOrigin = checkRandom(0, 1);
+            checkThat(display.pushClip(x, y, cw, ch, moveOrigin), "%dx%d op %d: pushClip() refused at depth %d", w, h, op, level);
+            int x0 = x + originX, y0 = y + originY;
+            if (moveOrigin) {
+                originX = x0;
+                originY = y0;
+            }
+            clipX0 = std::max(clipX0, x0);
+            clipY0 = std::max(clipY0, y0);
+            clipX1 = std::min(clipX1, x0 + cw - 1);
+            clipY1 = std::min(clipY1, y0 + ch - 1);
+        }
+
+        int kind = checkRandom(0, 12), x = checkRandom(-20, w + 20), y = checkRandom(-15, h + 15);
+        int a = checkRandom(-5, 44), b = checkRandom(-5, 44), color = checkRandom(0, 1), r = checkRandom(0, 1 << 20);
+        memcpy(before.data(), display.getBuffer(), size);
+        memcpy(unclipped.getBuffer(), display.getBuffer(), size);
+        drawRandom(display, kind, x, y, a, b, color, r);
+        drawRandom(unclipped, kind, x + originX, y + originY, a, b, color, r);
+
+        for (int py = 0; py < h; py++) {
+            for (int px = 0; px < w; px++) {
+                bool inside = px >= clipX0 && px <= clipX1 && py >= clipY0 && py <= clipY1;
+                bool want = bit(inside ? unclipped.getBuffer() : before.data(), w, px, py);
+                if (!checkThat(bit(display.getBuffer(), w, px, py) == want, "%dx%d op %d: primitive %d, pixel %d,%d, clip %d,%d-%d,%d origin %d,%d",
+                    w, h, op, kind, px, py, clipX0, clipY0, clipX1, clipY1, originX, originY)) return;
+            }
+        }
+
+        int gx = checkRandom(0, w - 1) - originX, gy = checkRandom(0, h - 1) - originY;
+        checkThat(display.getPixel(gx, gy) == bit(display.getBuffer(), w, gx + originX, gy + originY), "%dx%d op %d: getPixel(%d, %d) through the origin",
+            w, h, op, gx, gy);
+        if (op % 7 == 0) {
+            display.update();
+            if (!checkSame(panel.getMemory().data(), display.getBuffer(), size, "%dx%d op %d: panel after update(), primitive %d", w, h, op, kind)) return;
+        }
+    }
+
+    // the stack is SSD1306_CLIP_DEPTH deep, one more push is refused and popping too far is harmless
+    display.resetClip();
+    for (int i = 0; i < SSD1306_CLIP_DEPTH; i++) checkThat(display.pushClip(0, 0, 10, 10), "%dx%d: push %d refused", w, h, i);
+    checkThat(!display.pushClip(0, 0, 10, 10), "%dx%d: a push past SSD1306_CLIP_DEPTH was accepted", w, h);
+    for (int i = 0; i <= SSD1306_CLIP_DEPTH; i++) display.popClip();
+    display.drawPixel(w - 1, h - 1, 1);
+    checkThat(display.getPixel(w - 1, h - 1), "%dx%d: drawing after popping every clip", w, h);
+}
+
+int main() {
+    const uint8_t geometry[][2] = { { 128, 64 }, { 96, 16 }, { 64, 48 } };
+    for (const auto& g : geometry) checkGeometry(g[0], g[1]);
+    return checkDone("check_clip");
+}
@@ -0,0 +1,73 @@
+// Checks puroPixel_Console against the text it was given: after each of 400 random print()/println() calls (with
+// '\n' and lines longer than the panel), what mocktransport.h would show from its start line has to be the last
+// lines of that text, drawn with drawString(). Runs on 128x64 and 128x32, where the 64 rows of GDDRAM wrap.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_console.cpp -pthread -o check_console
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "console.h"
+#include "mocktransport.h"
+#include "check.h"
+#include <string>
+#include <vector>
+
+static void checkGeometry(uint8_t h) {
+    puroPixel_MockTransport panel(128, 64); // the controller always has 64 rows of memory, only h of them show
+    puroPixel_SSD1306 display(&panel, 128, h, true);
+    puroPixel_SSD1306 expected(nullptr, 128, h, true);
+    display.begin();
+    puroPixel_Console console(&display);
+    console.begin();
+    uint8_t rows = h / 8, columns = 128 / 6;
+    std::vector<std::string> lines(1);
+
+    for (int call = 0; call < 400; call++) {
+        std::string text;
+        int length = checkRandom(0, 30);
+        for (int i = 0; i < length; i++) text += checkRandom(0, 19) == 0 ? '\n' : (char)checkRandom('A', 'Z');
+        bool newline = checkRandom(0, 1);
+
+        for (char character : text) {
+            if (character == '\n') {
+                lines.emplace_back();
+                continue;
+            }
+            if (lines.back().size() >= columns) lines.emplace_back();
+            lines.back() += character;
+        }
+        if (newline) {
+            console.println(text.c_str());
+            lines.emplace_back();
+        }
+        else {
+            console.print(text.c_str());
+        }
+
+        // the last rows lines, but an empty last line only scrolls once it gets text
+        int total = lines.size();
+        int first = total > rows ? total - rows : 0;
+        if (total > rows && lines.back().empty()) first--;
+        expected.clear();
+        for (int row = 0; row < rows && first + row < total; row++) expected.drawString(0, row * 8, lines[first + row].c_str(), 1, 1, false, false);
+
+        std::vector<uint8_t> shown(128 * rows, 0);
+        for (int y = 0; y < h; y++) {
+            int ramRow = (panel.getStartLine() + y) & 63;
+            for (int x = 0; x < 128; x++) {
+                if ((panel.getMemory()[(ramRow / 8) * 128 + x] >> (ramRow & 7)) & 1) shown[(y / 8) * 128 + x] |= 1 << (y & 7);
+            }
+        }
+        if (!checkSame(shown.data(), expected.getBuffer(), shown.size(), "128x%d call %d: %s(\"%s\"), start line %d",
+            h, call, newline ? "println" : "print", text.c_str(), panel.getStartLine())) return;
+    }
+
+    console.end();
+    checkThat(panel.getStartLine() == 0, "128x%d: end() left the start line at %d", h, panel.getStartLine());
+}
+
+int main() {
+    checkGeometry(64);
+    checkGeometry(32);
+    return checkDone("check_console");
+}
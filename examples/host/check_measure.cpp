@@ -0,0 +1,65 @@
+// Checks measureString() and drawStringCached(). 3000 random strings (wrapped or not, scale 1 to 3, with and without
+// textBg): every pixel drawString() lights is inside the measured box (plus the scale-wide border with textBg),
+// and the height is the y drawString() returns. Then cached labels that randomly change, with an occasional
+// clear(), have to give exactly the buffer of redrawing all of them from scratch.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_measure.cpp -pthread -o check_measure
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "check.h"
+#include <string>
+
+static void checkMeasure() {
+    puroPixel_SSD1306 display(nullptr, 128, 64, true);
+    for (int op = 0; op < 3000; op++) {
+        std::string text;
+        int length = checkRandom(0, 40);
+        for (int i = 0; i < length; i++) text += checkRandom(0, 24) == 0 ? '\n' : (char)checkRandom(0x21, 0x7E);
+        int scale = checkRandom(1, 3);
+        bool textWrap = checkRandom(0, 1), textBg = checkRandom(0, 1);
+
+        display.fillScreen(0);
+        const int x = 10, y = 12;
+        stringPos end = display.drawString(x, y, text.c_str(), scale, 1, textBg, textWrap);
+        stringSize size = display.measureString(text.c_str(), scale, textWrap);
+
+        int border = textBg ? scale : 0;
+        int x0 = x - border, y0 = y - border, x1 = x + size.w + border - 1, y1 = y + size.h + border - 1;
+        for (int py = 0; py < 64; py++) {
+            for (int px = 0; px < 128; px++) {
+                if (!((display.getBuffer()[px + (py / 8) * 128] >> (py & 7)) & 1)) continue;
+                if (!checkThat(px >= x0 && px <= x1 && py >= y0 && py <= y1, "op %d \"%s\" scale %d wrap %d bg %d: pixel %d,%d outside %dx%d",
+                    op, text.c_str(), scale, textWrap, textBg, px, py, size.w, size.h)) return;
+            }
+        }
+        checkThat(size.w == 0 || end.y == size.h, "op %d \"%s\": measured height %d, drawString returned y %d", op, text.c_str(), size.h, end.y);
+    }
+}
+
+static void checkCachedLabels() {
+    puroPixel_SSD1306 display(nullptr, 128, 64, true), fresh(nullptr, 128, 64, true);
+    const char* words[] = { "12", "7", "hello", "-3.5", "OK", "" };
+    const int labelX[4] = { 0, 64, 0, 64 }, labelY[4] = { 0, 0, 30, 30 };
+    textRun runs[4] = {};
+    int current[4] = { 0, 0, 0, 0 };
+    int draws = 0;
+    display.clear();
+
+    for (int op = 0; op < 2000; op++) {
+        int changed = checkRandom(0, 3);
+        if (checkRandom(0, 2) == 0) current[changed] = checkRandom(0, 5);
+        if (checkRandom(0, 50) == 0) display.clear();
+        for (int i = 0; i < 4; i++) draws += display.drawStringCached(runs[i], labelX[i], labelY[i], words[current[i]], 2, 1, i & 1);
+        fresh.clear();
+        for (int i = 0; i < 4; i++) fresh.drawString(labelX[i], labelY[i], words[current[i]], 2, 1, i & 1);
+        if (!checkSame(display.getBuffer(), fresh.getBuffer(), 1024, "op %d: cached labels against a redraw", op)) return;
+    }
+    checkThat(draws < 2000 * 4 / 2, "cached labels drew %d times out of %d", draws, 2000 * 4);
+}
+
+int main() {
+    checkMeasure();
+    checkCachedLabels();
+    return checkDone("check_measure");
+}
@@ -0,0 +1,98 @@
+// Checks drawPageBitmap() in its three modes against a pixel-by-pixel reference, and the transparent mode against
+// drawBitmap() with the same image in row order: 20000 random sizes, positions and colors per geometry, compared
+// after every call. update() is replayed into mocktransport.h as well.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_pagebitmap.cpp -pthread -o check_pagebitmap
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "mocktransport.h"
+#include "check.h"
+#include <vector>
+
+struct referenceBlit {
+    int w, h;
+    std::vector<unsigned char> buffer;
+
+    referenceBlit(int width, int height) : w(width), h(height), buffer(width * (height / 8), 0) {}
+
+    bool get(int x, int y) { return (buffer[x + (y / 8) * w] >> (y & 7)) & 1; }
+    void set(int x, int y, bool on) {
+        if (on) buffer[x + (y / 8) * w] |= 1 << (y & 7);
+        else buffer[x + (y / 8) * w] &= ~(1 << (y & 7));
+    }
+
+    void blit(int x, int y, const uint8_t* pages, int bw, int bh, BlitMode mode, int color) {
+        for (int i = 0; i < bw; i++) {
+            for (int j = 0; j < bh; j++) {
+                int px = x + i, py = y + j;
+                if (px < 0 || px >= w || py < 0 || py >= h) continue;
+                bool bit = (pages[(j / 8) * bw + i] >> (j & 7)) & 1;
+                if (mode == BLIT_XOR) {
+                    if (bit) set(px, py, !get(px, py));
+                }
+                else if (bit) set(px, py, color == 1);
+                else if (mode == BLIT_OPAQUE) set(px, py, color != 1);
+            }
+        }
+    }
+};
+
+// the same image in drawBitmap's row order, MSB on the left
+static void toRows(const uint8_t* pages, int w, int h, uint8_t* rows) {
+    int rowBytes = (w + 7) / 8;
+    memset(rows, 0, rowBytes * h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if ((pages[(y / 8) * w + x] >> (y & 7)) & 1) rows[y * rowBytes + x / 8] |= 0x80 >> (x & 7);
+        }
+    }
+}
+
+static void checkGeometry(uint8_t w, uint8_t h) {
+    puroPixel_MockTransport panel(w, h);
+    puroPixel_SSD1306 display(&panel, w, h, true);
+    puroPixel_SSD1306 rowDisplay(nullptr, w, h, true);
+    display.begin();
+    rowDisplay.clear();
+    referenceBlit reference(w, h);
+    size_t size = reference.buffer.size();
+    static uint8_t pages[64 * 8], rows[64 * 8];
+
+    for (int op = 0; op < 20000; op++) {
+        int bw = checkRandom(1, 64), bh = checkRandom(1, 64);
+        for (int i = 0; i < bw * ((bh + 7) / 8); i++) pages[i] = checkRandom(0, 255);
+        int x = checkRandom(-70, w + 5), y = checkRandom(-70, h + 5);
+        int color = checkRandom(0, 4) == 0 ? 2 : checkRandom(0, 1);
+        BlitMode mode = (BlitMode)checkRandom(0, 2);
+
+        std::vector<unsigned char> before(display.getBuffer(), display.getBuffer() + size);
+        display.drawPageBitmap(x, y, pages, bw, bh, mode, color);
+        reference.blit(x, y, pages, bw, bh, mode, color);
+        if (!checkSame(display.getBuffer(), reference.buffer.data(), size, "%dx%d op %d: mode %d, %dx%d at %d,%d color %d",
+            w, h, op, mode, bw, bh, x, y, color)) return;
+
+        if (mode == BLIT_TRANSPARENT) {
+            // drawBitmap from the same starting buffer has to end up with the same pixels
+            memcpy(rowDisplay.getBuffer(), before.data(), size);
+            toRows(pages, bw, bh, rows);
+            rowDisplay.drawBitmap(x, y, rows, bw, bh, color);
+            if (!checkSame(display.getBuffer(), rowDisplay.getBuffer(), size, "%dx%d op %d: drawBitmap %dx%d at %d,%d color %d",
+                w, h, op, bw, bh, x, y, color)) return;
+        }
+        if (checkRandom(0, 30) == 0) {
+            display.clear();
+            reference.buffer.assign(size, 0);
+        }
+        if (op % 100 == 99) {
+            display.update();
+            if (!checkSame(panel.getMemory().data(), display.getBuffer(), size, "%dx%d op %d: panel after update()", w, h, op)) return;
+        }
+    }
+}
+
+int main() {
+    const uint8_t geometry[][2] = { { 128, 64 }, { 128, 32 }, { 96, 16 }, { 64, 48 } };
+    for (const auto& g : geometry) checkGeometry(g[0], g[1]);
+    return checkDone("check_pagebitmap");
+}
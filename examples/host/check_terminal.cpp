@@ -0,0 +1,140 @@
+// Checks puroPixel_Terminal against a plain model of its grid, drawn cell by cell with drawString(): random putAt(),
+// printf() with line feeds and scrolling, inverse cells and clear() on 128x64, 128x32 and 128x16. After each
+// render() + update() the panel (mocktransport.h) has to show the model, the data bytes sent have to be exactly the
+// windows getWindows() reports, and a second render() with nothing changed has to send nothing.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_terminal.cpp -pthread -o check_terminal
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "terminal.h"
+#include "mocktransport.h"
+#include "check.h"
+
+struct gridModel {
+    int cols, rows;
+    int cursorX = 0, cursorY = 0;
+    char cells[SSD1306_TERMINAL_ROWS][SSD1306_TERMINAL_COLS];
+    bool inverse[SSD1306_TERMINAL_ROWS][SSD1306_TERMINAL_COLS];
+
+    gridModel(int c, int r) : cols(c), rows(r) { clear(); }
+
+    void clear() {
+        memset(cells, ' ', sizeof(cells));
+        memset(inverse, 0, sizeof(inverse));
+        cursorX = cursorY = 0;
+    }
+    void newLine() {
+        cursorX = 0;
+        if (++cursorY < rows) return;
+        memmove(cells[0], cells[1], sizeof(cells[0]) * (rows - 1));
+        memmove(inverse[0], inverse[1], sizeof(inverse[0]) * (rows - 1));
+        memset(cells[rows - 1], ' ', sizeof(cells[0]));
+        memset(inverse[rows - 1], 0, sizeof(inverse[0]));
+        cursorY = rows - 1;
+    }
+    void write(const char* text) {
+        for (; *text; text++) {
+            if (*text == '\n') {
+                newLine();
+                continue;
+            }
+            if (cursorX >= cols) newLine();
+            cells[cursorY][cursorX] = *text;
+            inverse[cursorY][cursorX] = false;
+            cursorX++;
+        }
+    }
+    void putAt(int col, int row, const char* text, bool inv) {
+        for (int i = 0; text[i] && col + i < cols; i++) {
+            cells[row][col + i] = text[i];
+            inverse[row][col + i] = inv;
+        }
+    }
+    void draw(puroPixel_SSD1306& display) {
+        display.clear();
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                char text[2] = { cells[row][col], '\0' };
+                display.drawString(col * 6, row * 8, text, 1, 1, false, false);
+                if (!inverse[row][col]) continue;
+                for (int i = 0; i < 6; i++) display.getBuffer()[row * display.getWidth() + col * 6 + i] ^= 0xFF;
+            }
+        }
+    }
+};
+
+static uint32_t dataBytes(puroPixel_MockTransport& panel) {
+    uint32_t bytes = 0;
+    for (const mockTransfer& transfer : panel.getLog()) {
+        if (transfer.isData) bytes += transfer.bytes.size();
+    }
+    return bytes;
+}
+
+static void checkGeometry(uint8_t h) {
+    puroPixel_MockTransport panel(128, h);
+    puroPixel_SSD1306 display(&panel, 128, h, true);
+    puroPixel_SSD1306 expected(nullptr, 128, h, true);
+    display.begin();
+    puroPixel_Terminal terminal(&display);
+    gridModel model(terminal.getCols(), terminal.getRows());
+    size_t size = 128 * h / 8;
+
+    for (int op = 0; op < 3000; op++) {
+        switch (checkRandom(0, 3)) {
+        case 0:
+            if (checkRandom(0, 10) != 0) break;
+            terminal.clear();
+            model.clear();
+            break;
+        case 1: {
+            char text[6];
+            int length = checkRandom(0, 5);
+            for (int i = 0; i < length; i++) text[i] = (char)checkRandom('!', 0x7E);
+            text[length] = '\0';
+            int col = checkRandom(0, model.cols - 1), row = checkRandom(0, model.rows - 1);
+            bool inverse = checkRandom(0, 1);
+            terminal.setInverse(inverse);
+            terminal.putAt(col, row, text);
+            model.putAt(col, row, text, inverse);
+            break;
+        }
+        case 2: {
+            char text[16];
+            snprintf(text, sizeof(text), "%d\n", checkRandom(0, 99999));
+            terminal.setInverse(false);
+            terminal.printf("%s", text);
+            model.write(text);
+            break;
+        }
+        default: {
+            panel.clearLog();
+            terminal.render();
+            termWindow windows[SSD1306_TERMINAL_ROWS];
+            uint8_t count = terminal.getWindows(windows, SSD1306_TERMINAL_ROWS);
+            uint32_t windowBytes = 0;
+            for (uint8_t i = 0; i < count; i++) windowBytes += windows[i].col1 - windows[i].col0 + 1;
+            display.update();
+            checkThat(dataBytes(panel) == windowBytes, "128x%d op %d: %u data bytes sent for %u bytes of windows", h, op, dataBytes(panel), windowBytes);
+
+            model.draw(expected);
+            if (!checkSame(panel.getMemory().data(), expected.getBuffer(), size, "128x%d op %d: panel after render()", h, op)) return;
+
+            panel.clearLog();
+            uint16_t drawn = terminal.render();
+            display.update();
+            checkThat(drawn == 0 && panel.getLog().empty(), "128x%d op %d: an unchanged render() drew %u cells, sent %u transfers",
+                h, op, drawn, (unsigned)panel.getLog().size());
+            break;
+        }
+        }
+    }
+}
+
+int main() {
+    checkGeometry(64);
+    checkGeometry(32);
+    checkGeometry(16);
+    return checkDone("check_terminal");
+}
@@ -0,0 +1,135 @@
+// Checks drawString() against the pixel-by-pixel renderer it replaced: random strings (control bytes, '\n' and bytes
+// above 0x7F included), scales 1 to 6, both colors, with and without background and wrap, on several geometries.
+// Compares the buffer and the returned position after every call, and replays update() into mocktransport.h.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_text.cpp -pthread -o check_text
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "font.h"
+#include "mocktransport.h"
+#include "check.h"
+#include <vector>
+#include <thread>
+
+// the old drawString: every font pixel as a scale x scale block of single pixels, the background as 7 x 9 blocks
+struct referenceText {
+    int w, h;
+    std::vector<unsigned char> buffer;
+
+    referenceText(int width, int height) : w(width), h(height), buffer(width * (height / 8), 0) {}
+
+    void pixel(int x, int y, int color) {
+        if (x < 0 || x >= w || y < 0 || y >= h) return;
+        if (color == 1) buffer[x + (y / 8) * w] |= 1 << (y & 7);
+        else buffer[x + (y / 8) * w] &= ~(1 << (y & 7));
+    }
+
+    stringPos string(int x, int y, const char* str, int scale, int color, bool textBg, bool textWrap) {
+        int xOffset = 0, yOffset = 0;
+        int charWidth = 6 * scale, charHeight = 8 * scale;
+        for (int i = 0; str[i] != '\0'; i++) {
+            uint8_t character = str[i];
+            if (character == '\n') {
+                xOffset = 0;
+                yOffset += charHeight;
+                continue;
+            }
+            if (character < 0x20 || character > 0x7F) continue;
+            if (textWrap && xOffset + charWidth > w) {
+                xOffset = 0;
+                yOffset += charHeight;
+            }
+            const char* glyph = ASCII[character - 0x20];
+            for (int cx = -1; textBg && cx <= 5; cx++) {
+                for (int j = -1; j <= 7; j++) block(x + xOffset + cx * scale, y + yOffset + j * scale, scale, !color);
+            }
+            for (int cx = 0; cx < 5; cx++) {
+                for (int j = 0; j < 7; j++) {
+                    if ((glyph[cx] >> j) & 1) block(x + xOffset + cx * scale, y + yOffset + j * scale, scale, color);
+                }
+            }
+            xOffset += charWidth;
+        }
+        return { xOffset, yOffset + 7 * scale };
+    }
+
+    void block(int x, int y, int scale, int color) {
+        for (int dx = 0; dx < scale; dx++) {
+            for (int dy = 0; dy < scale; dy++) pixel((int16_t)(x + dx), (int16_t)(y + dy), color);
+        }
+    }
+};
+
+static void randomString(char* out, int length) {
+    for (int i = 0; i < length; i++) {
+        int kind = checkRandom(0, 20);
+        if (kind == 0) out[i] = '\n';
+        else if (kind == 1) out[i] = (char)checkRandom(1, 0x1F);
+        else if (kind == 2) out[i] = (char)checkRandom(0x80, 0xFF);
+        else out[i] = (char)checkRandom(0x20, 0x7F);
+    }
+    out[length] = '\0';
+}
+
+static void checkGeometry(uint8_t w, uint8_t h) {
+    puroPixel_MockTransport panel(w, h);
+    puroPixel_SSD1306 display(&panel, w, h, true);
+    display.begin();
+    referenceText reference(w, h);
+
+    for (int op = 0; op < 20000; op++) {
+        char text[40];
+        randomString(text, checkRandom(0, 30));
+        int x = checkRandom(-60, w + 10), y = checkRandom(-60, h + 10);
+        int scale = checkRandom(1, 6), color = checkRandom(0, 2);
+        bool textBg = checkRandom(0, 1), textWrap = checkRandom(0, 1);
+        stringPos got = display.drawString(x, y, text, scale, color, textBg, textWrap);
+        stringPos want = reference.string(x, y, text, scale, color, textBg, textWrap);
+        if (!checkSame(display.getBuffer(), reference.buffer.data(), reference.buffer.size(), "%dx%d op %d: drawString at %d,%d scale %d color %d bg %d wrap %d",
+            w, h, op, x, y, scale, color, textBg, textWrap)) return;
+        if (!checkThat(got.x == want.x && got.y == want.y, "%dx%d op %d: returned %d,%d instead of %d,%d", w, h, op, got.x, got.y, want.x, want.y)) return;
+        if (op % 50 == 49) {
+            display.update();
+            if (!checkSame(panel.getMemory().data(), display.getBuffer(), reference.buffer.size(), "%dx%d op %d: panel after update()", w, h, op)) return;
+        }
+        if (checkRandom(0, 200) == 0) {
+            display.clear();
+            reference.buffer.assign(reference.buffer.size(), 0);
+        }
+    }
+}
+
+// two displays drawing scaled text from two threads at once, each with its own glyph cache (build with
+// -fsanitize=thread to see a shared one race)
+static void drawTask(puroPixel_SSD1306* display, uint32_t seed, bool* same) {
+    referenceText reference(display->getWidth(), display->getHeight());
+    display->clear();
+    *same = true;
+    for (int op = 0; op < 3000 && *same; op++) {
+        seed = seed * 1103515245u + 12345u;
+        char text[2] = { (char)(0x20 + (seed >> 8) % 0x60), '\0' };
+        int scale = 2 + (seed >> 16) % 3, x = (seed >> 4) % 120, y = (seed >> 20) % 60;
+        display->drawString(x, y, text, scale);
+        reference.string(x, y, text, scale, 1, false, true);
+        *same = memcmp(display->getBuffer(), reference.buffer.data(), reference.buffer.size()) == 0;
+    }
+}
+
+static void checkTasks() {
+    puroPixel_SSD1306 heapDisplay(0x3C, 128, 64, &Wire, true);
+    static puroPixel_SSD1306_Static<128, 32> staticDisplay(0x3D, &Wire, true);
+    bool sameHeap = false, sameStatic = false;
+    std::thread first(drawTask, &heapDisplay, 1u, &sameHeap);
+    std::thread second(drawTask, &staticDisplay, 2u, &sameStatic);
+    first.join();
+    second.join();
+    checkThat(sameHeap && sameStatic, "text drawn from two threads (heap %d, static %d)", sameHeap, sameStatic);
+}
+
+int main() {
+    const uint8_t geometry[][2] = { { 128, 64 }, { 128, 32 }, { 96, 16 }, { 64, 48 } };
+    for (const auto& g : geometry) checkGeometry(g[0], g[1]);
+    checkTasks();
+    return checkDone("check_text");
+}
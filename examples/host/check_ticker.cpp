@@ -0,0 +1,81 @@
+// Checks scrollContent() and puroPixel_Ticker on the I2C transport: the recorded Wire traffic is played into
+// mocktransport.h, which moves its memory like the panel does for a content scroll, and has to match the buffer
+// after 5000 mixed draws, updates and scroll steps, with and without the shadow buffer, on several geometries.
+// A step alone sends only the step, the window and the incoming column, and needs no resend afterwards.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_ticker.cpp -pthread -o check_ticker
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "ticker.h"
+#include "mocktransport.h"
+#include "check.h"
+
+static void replay(puroPixel_MockTransport& panel) {
+    for (const WireTransaction& transaction : Wire.getLog()) {
+        const uint8_t* payload = transaction.bytes.data() + 1;
+        uint16_t length = transaction.bytes.size() - 1;
+        if (transaction.bytes[0] == SSD1306_CONTROL_DATA) panel.data(payload, length);
+        else panel.commands(payload, length);
+    }
+    Wire.resetStats();
+}
+
+static void checkGeometry(uint8_t w, uint8_t h, bool shadow) {
+    puroPixel_MockTransport panel(w, h);
+    puroPixel_SSD1306 display(0x3C, w, h, &Wire, true);
+    Wire.begin();
+    Wire.setRecording(true);
+    Wire.resetStats();
+    display.begin();
+    if (shadow) display.enableShadow();
+    replay(panel);
+    uint8_t pages = h / 8;
+    puroPixel_Ticker ticker(&display, pages > 2 ? pages - 3 : 0, 2);
+    ticker.setText("Hello ticker! ", checkRandom(1, 2), 10);
+    size_t size = w * pages;
+
+    for (int op = 0; op < 5000; op++) {
+        switch (checkRandom(0, 6)) {
+        case 0: display.drawFillRect(checkRandom(-6, w + 6), checkRandom(-3, h + 3), checkRandom(0, 30), checkRandom(0, 30), checkRandom(0, 1)); break;
+        case 1: display.drawString(checkRandom(0, w - 1), checkRandom(0, h - 1), "x", 1); break;
+        case 2: display.update(); break;
+        case 3:
+        case 4: ticker.stepNow(); break;
+        case 5: {
+            uint8_t column[SSD1306_MAX_PAGES];
+            for (uint8_t i = 0; i < SSD1306_MAX_PAGES; i++) column[i] = checkRandom(0, 255);
+            display.scrollContent(checkRandom(0, pages - 1), checkRandom(0, pages - 1), column, checkRandom(0, 1));
+            break;
+        }
+        case 6: if (checkRandom(0, 20) == 0) display.clear(); break;
+        }
+        if (op % 97 == 0) {
+            display.update();
+            replay(panel);
+            if (!checkSame(panel.getMemory().data(), display.getBuffer(), size, "%dx%d shadow %d, op %d", w, h, shadow, op)) return;
+        }
+    }
+
+    // one step on its own: step + window in one command transaction, then the two bytes of the column
+    display.update();
+    replay(panel);
+    ticker.stepNow();
+    const std::vector<WireTransaction>& log = Wire.getLog();
+    checkThat(log.size() == 2 && log[1].bytes.size() == 3, "%dx%d: a step took %u transactions", w, h, (unsigned)log.size());
+    replay(panel);
+    display.update();
+    checkThat(Wire.getLog().empty(), "%dx%d: update() after a step sent %u transactions", w, h, (unsigned)Wire.getLog().size());
+    checkSame(panel.getMemory().data(), display.getBuffer(), size, "%dx%d shadow %d, after one step", w, h, shadow);
+    checkThat(panel.getStartLine() == 0, "%dx%d: start line %d after content scrolls", w, h, panel.getStartLine());
+    Wire.setRecording(false);
+}
+
+int main() {
+    const uint8_t geometry[][2] = { { 128, 64 }, { 128, 32 }, { 64, 48 } };
+    for (const auto& g : geometry) {
+        checkGeometry(g[0], g[1], false);
+        checkGeometry(g[0], g[1], true);
+    }
+    return checkDone("check_ticker");
+}
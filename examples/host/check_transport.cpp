@@ -0,0 +1,159 @@
+// Replays everything the display sends into mocktransport.h's model of the panel and compares it with getBuffer():
+// update(), the shadow buffer, updateAsync(), flushStep(), frame pacing, scrollContent() and the ticker, on
+// several geometries. Also checks the mock itself (arguments split over calls, start line) and the SPI transport.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/check_transport.cpp -pthread -o check_transport
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "SPI.h"
+#include "ssd1306.h"
+#include "ticker.h"
+#include "mocktransport.h"
+#include "check.h"
+
+static void randomDraw(puroPixel_SSD1306& display) {
+    int x = checkRandom(-20, display.getWidth() + 10), y = checkRandom(-20, display.getHeight() + 10);
+    uint16_t color = checkRandom(0, 1);
+    switch (checkRandom(0, 5)) {
+    case 0: display.drawPixel(x, y, color); break;
+    case 1: display.drawFillRect(x, y, checkRandom(0, 40), checkRandom(0, 40), color); break;
+    case 2: display.drawString(x, y, "AbC 12", checkRandom(1, 3), color, checkRandom(0, 1)); break;
+    case 3: display.drawCircle(x, y, checkRandom(0, 20), color); break;
+    case 4: if (checkRandom(0, 20) == 0) display.clear(); break;
+    case 5: if (checkRandom(0, 50) == 0) display.invert(); break;
+    }
+}
+
+// random draws mixed with every way a frame can leave, the panel has to end up with the buffer
+static void checkTraffic(uint8_t w, uint8_t h, bool shadow, bool async, bool paced) {
+    puroPixel_MockTransport panel(w, h);
+    puroPixel_SSD1306 display(&panel, w, h, true);
+    display.begin();
+    if (shadow) display.enableShadow(true, checkRandom(0, 10));
+    if (async) display.beginAsync();
+    if (paced) display.setFramePeriod(1);
+    puroPixel_Ticker ticker(&display, h / 8 - 2, 2);
+    ticker.setText("Ticker text ", checkRandom(1, 2), 10);
+
+    for (int op = 0; op < 20000; op++) {
+        switch (checkRandom(0, 9)) {
+        case 0: display.update(); break;
+        case 1: display.updateAsync(); break;
+        case 2: display.flushStep(checkRandom(1, 100)); break;
+        case 3: display.tick(); break;
+        case 4: if (checkRandom(0, 10) == 0) ticker.stepNow(); break;
+        case 5:
+            if (checkRandom(0, 10) == 0) {
+                uint8_t column[SSD1306_MAX_PAGES];
+                for (uint8_t i = 0; i < SSD1306_MAX_PAGES; i++) column[i] = checkRandom(0, 255);
+                display.scrollContent(checkRandom(0, h / 8 - 1), checkRandom(0, h / 8 - 1), column, checkRandom(0, 1));
+            }
+            break;
+        default: randomDraw(display); break;
+        }
+        if (op % 1000 == 999) {
+            display.updateNow();
+            display.waitForFlush();
+            if (!checkSame(panel.getMemory().data(), display.getBuffer(), w * h / 8, "%dx%d shadow=%d async=%d paced=%d, op %d",
+                w, h, shadow, async, paced, op)) break;
+        }
+    }
+    checkThat(panel.getStartLine() == 0, "%dx%d: start line %d after content scrolls", w, h, panel.getStartLine());
+    display.endAsync();
+}
+
+// the mock parses commands with their arguments, even when they come over several calls
+static void checkMock() {
+    puroPixel_MockTransport panel(128, 64);
+    const uint8_t contrast[] = { SSD1306_SETCONTRAST, 0x7F, SSD1306_SETMULTIPLEX, 0x40 + 5 };
+    panel.commands(contrast, sizeof(contrast));
+    checkThat(panel.getStartLine() == 0, "argument bytes taken as a start line");
+
+    const uint8_t window[] = { SSD1306_PAGEADDR, 2, 3, SSD1306_COLUMNADDR, 10 };
+    panel.commands(window, sizeof(window));
+    const uint8_t end[] = { 11 };
+    panel.commands(end, sizeof(end));
+    const uint8_t bytes[] = { 1, 2, 3, 4 };
+    panel.data(bytes, sizeof(bytes));
+    const std::vector<uint8_t>& memory = panel.getMemory();
+    checkThat(memory[2 * 128 + 10] == 1 && memory[2 * 128 + 11] == 2 && memory[3 * 128 + 10] == 3 && memory[3 * 128 + 11] == 4,
+        "window split over two calls");
+    checkThat(memory[2 * 128 + 12] == 0 && memory[4 * 128 + 10] == 0, "data outside the window");
+
+    const uint8_t scroll[] = { SSD1306_CONTENT_SCROLL_LEFT, 0x00, 2, 0x01, 2, 0x00, 127, SSD1306_SETSTARTLINE | 9 };
+    panel.commands(scroll, sizeof(scroll));
+    checkThat(memory[2 * 128 + 9] == 1 && memory[2 * 128 + 10] == 2 && memory[3 * 128 + 10] == 3, "content scroll left");
+    checkThat(panel.getStartLine() == 9, "start line %d, expected 9", panel.getStartLine());
+}
+
+// the same frames through the SPI transport, its recorded transfers played into the mock
+static void checkSPI() {
+    const int8_t DC = 4, CS = 5, RST = 6;
+    puroPixel_SPITransport spi(&SPI, DC, CS, RST);
+    puroPixel_SSD1306 display(&spi, 128, 64, true);
+    SPI.setRecording(true, DC);
+    display.begin();
+    display.enableShadow();
+    puroPixel_MockTransport panel;
+    for (int op = 0; op < 3000; op++) {
+        randomDraw(display);
+        if (op % 7 != 0) continue;
+        display.update();
+        for (const SPITransfer& transfer : SPI.getLog()) {
+            if (transfer.dc) panel.data(transfer.bytes.data(), transfer.bytes.size());
+            else panel.commands(transfer.bytes.data(), transfer.bytes.size());
+        }
+        SPI.resetStats();
+        if (!checkSame(panel.getMemory().data(), display.getBuffer(), 1024, "SPI, op %d", op)) break;
+    }
+    SPI.setRecording(false, DC);
+}
+
+// a paced frame that flushStep() sent in pieces isn't sent (or counted) again by tick()
+static void checkSteppedFrame() {
+    puroPixel_MockTransport panel;
+    puroPixel_SSD1306 display(&panel, 128, 64, true);
+    display.begin();
+    display.setFramePeriod(1);
+    display.getFramePacing(true);
+    display.drawFillRect(0, 0, 100, 40);
+    display.update();
+    while (display.flushStep(100) > 0) {}
+    checkThat(!display.isFramePending(), "frame still pending after flushStep() sent it");
+    uint32_t transactions = panel.getTransactions();
+    delay(2);
+    checkThat(!display.tick() && panel.getTransactions() == transactions, "tick() sent a frame flushStep() already sent");
+    checkThat(display.getFramePacing().frames == 0, "tick() counted a frame flushStep() sent");
+}
+
+// nullptr never leaves a display without a transport
+static void checkNoTransport() {
+    puroPixel_MockTransport panel(128, 32);
+    puroPixel_SSD1306_Static<128, 32> display(&panel, true);
+    display.setTransport(nullptr);
+    checkThat(display.getTransport() == &panel, "setTransport(nullptr) dropped the transport of a transport-built display");
+
+    puroPixel_SSD1306 wired(0x3C, 128, 64, &Wire, true);
+    wired.setTransport(&panel);
+    wired.setTransport(nullptr);
+    checkThat(wired.getTransport() != &panel, "setTransport(nullptr) didn't go back to the TwoWire");
+
+    puroPixel_SSD1306 none(nullptr, 128, 64, true); // nothing to send to, but it must not crash
+    none.begin();
+    none.drawString(0, 0, "no bus");
+    none.update();
+    none.setTransport(nullptr);
+    none.update();
+}
+
+int main() {
+    const uint8_t geometry[][2] = { { 128, 64 }, { 128, 32 }, { 64, 48 } };
+    for (const auto& g : geometry) {
+        for (int mode = 0; mode < 8; mode++) checkTraffic(g[0], g[1], mode & 1, mode & 2, mode & 4);
+    }
+    checkMock();
+    checkSPI();
+    checkSteppedFrame();
+    checkNoTransport();
+    return checkDone("check_transport");
+}
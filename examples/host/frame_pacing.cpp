@@ -0,0 +1,60 @@
+// An app whose modules each call update() after drawing: 4 frames per loop() run. Prints the bus load for one second
+// with plain update() and with setFramePeriod(33), plus what getFramePacing() counted.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/frame_pacing.cpp -pthread -o frame_pacing
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+
+static void runModules(puroPixel_SSD1306& display, uint32_t loops) {
+    char text[16];
+    snprintf(text, sizeof(text), "%02lu:%02lu", (unsigned long)(millis() / 60000) % 60, (unsigned long)(millis() / 1000) % 60);
+    display.drawString(0, 0, text, 2, 1, true);
+    display.update(); // clock module
+
+    display.drawFillRect(0, 24, 100, 8, 0);
+    display.drawFillRect(0, 24, loops % 100, 8);
+    display.update(); // progress bar module
+
+    display.drawFillCircle(116, 8, 6, (millis() / 250) % 2);
+    display.update(); // blinking status icon
+
+    snprintf(text, sizeof(text), "loop %lu", (unsigned long)loops);
+    display.drawString(0, 48, text, 1, 1, true);
+    display.update(); // debug counter
+}
+
+static void run(puroPixel_SSD1306& display, uint16_t period) {
+    display.setFramePeriod(period);
+    display.getFramePacing(true);
+    Wire.resetStats();
+
+    uint32_t loops = 0;
+    uint32_t start = millis();
+    while (millis() - start < 1000) {
+        runModules(display, loops++);
+        display.tick();
+        delay(1); // the rest of loop()
+    }
+    display.setFramePeriod(0);
+
+    const WireStats& s = Wire.getStats();
+    printf("period %2u ms: %5lu loops, %6u txn %7u bytes, %6.1f ms of bus time @400k per second\n", period,
+        (unsigned long)loops, s.transactions, s.bytes, Wire.estimateMicros(400000) / 1000);
+    if (period != 0) {
+        framePacing p = display.getFramePacing();
+        printf("              %lu update() calls, %lu frames sent, %lu coalesced, %lu periods dropped\n",
+            (unsigned long)p.requests, (unsigned long)p.frames, (unsigned long)p.coalesced, (unsigned long)p.dropped);
+    }
+}
+
+int main() {
+    puroPixel_SSD1306 display(0x3C, 128, 64, &Wire, true);
+    Wire.begin();
+    display.begin();
+    display.enableShadow();
+
+    run(display, 0);
+    run(display, 33);
+    return 0;
+}
@@ -0,0 +1,68 @@
+// What getStats() shows for two ways of drawing the same status screen: clear() + redraw everything every frame,
+// and keeping the buffer and only redrawing the value that changed. One CSV line per frame, then the histograms.
+// Build: g++ -std=gnu++11 -O2 -DSSD1306_ENABLE_STATS -I examples/host -I . *.cpp examples/host/host.cpp examples/host/frame_stats.cpp -pthread -o frame_stats
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+
+static const int FRAMES = 8;
+
+static void drawScreen(puroPixel_SSD1306& display, int frame, bool redrawAll) {
+    char value[16];
+    snprintf(value, sizeof(value), "%3d C", 20 + frame % 3);
+    if (redrawAll) {
+        display.clear();
+        display.drawRoundRect(0, 0, 128, 64, 6);
+        display.drawString(8, 6, "Temperature");
+        display.drawCircle(100, 40, 12);
+    }
+    display.drawString(8, 30, value, 2, 1, true);
+}
+
+static void printHistogram(const char* name, const uint16_t* histogram) {
+    printf("%s", name);
+    for (uint8_t i = 0; i < SSD1306_STATS_BUCKETS; i++) {
+        if (i < SSD1306_STATS_BUCKETS - 1) printf(" <%lu:%u", 256UL << i, histogram[i]);
+        else printf(" more:%u", histogram[i]);
+    }
+    printf("\n");
+}
+
+static void run(const char* name, bool redrawAll) {
+    puroPixel_SSD1306 display(0x3C, 128, 64, &Wire, true);
+    display.begin();
+    drawScreen(display, 0, true);
+    display.update();
+    display.resetStats();
+
+    printf("%s\nframe,calls,pixels,dirty,data,bus,transactions\n", name);
+    displayStats total = {};
+    for (int frame = 1; frame <= FRAMES; frame++) {
+        drawScreen(display, frame, redrawAll);
+        display.update();
+
+        displayStats s = display.getStats(true); // per frame
+        uint32_t calls = 0;
+        for (uint8_t i = 0; i < STAT_KINDS; i++) calls += s.calls[i];
+        printf("%d,%u,%u,%u,%u,%u,%u\n", frame, calls, s.pixels, s.dirtyBytes, s.dataBytes, s.busBytes, s.transactions);
+
+        total.dirtyBytes += s.dirtyBytes;
+        total.dataBytes += s.dataBytes;
+        for (uint8_t i = 0; i < SSD1306_STATS_BUCKETS; i++) {
+            total.updateLatency[i] += s.updateLatency[i];
+            total.renderLatency[i] += s.renderLatency[i];
+        }
+    }
+    printf("dirty coverage %.1f %%, sent %u of %u dirty bytes\n", total.dirtyBytes * 100.0 / (FRAMES * 1024), total.dataBytes, total.dirtyBytes);
+    printHistogram("update us", total.updateLatency);
+    printHistogram("render us", total.renderLatency);
+    printf("\n");
+}
+
+int main() {
+    Wire.begin();
+    run("clear() + redraw all", true);
+    run("redraw the value only", false);
+    return 0;
+}
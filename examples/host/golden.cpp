@@ -0,0 +1,152 @@
+// Headless rendering: golden images for the drawing functions and frame throughput, no panel and no bus.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/golden.cpp -pthread -o golden
+// Usage: ./golden --save DIR               render every scene into DIR/<scene>.pbm (on a version you trust)
+//        ./golden --check DIR [--diff DIR] compare with them, the diff PBMs show the pixels that changed
+// examples/host/golden has the images to check against: the scenes the first version of the library could draw were
+// rendered by it, the others by the change that added their functions. ./golden --check examples/host/golden
+//        ./golden --bench N [--stream F]   render N frames of a busy screen, optionally recording them all into F
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "capture.h"
+#include <chrono>
+#include <string>
+
+struct Scene {
+    const char* name;
+    void (*draw)(puroPixel_SSD1306& d);
+};
+
+static const Scene scenes[] = {
+    { "string_s1", [](puroPixel_SSD1306& d) { d.drawString(0, 0, "The quick brown fox jumps over the lazy dog 0123456789 !?#$%&"); } },
+    { "string_scales", [](puroPixel_SSD1306& d) {
+        d.drawString(0, 0, "s2", 2);
+        d.drawString(30, 0, "s3", 3);
+        d.drawString(70, 0, "s4", 4);
+        d.drawString(0, 36, "s5", 5);
+    } },
+    { "string_bg_wrap", [](puroPixel_SSD1306& d) {
+        d.fillScreen();
+        d.drawString(3, 3, "Inverted text that wraps around", 1, 0, true);
+        d.drawString(-5, 40, "Cut off", 2, 0, true, false);
+    } },
+    { "bitmap", [](puroPixel_SSD1306& d) { d.drawBitmap(0, 0, epd_bitmap_splash_puro_pixel, 128, 64); } },
+    { "bitmap_offset", [](puroPixel_SSD1306& d) {
+        d.fillScreen();
+        d.drawBitmap(-17, 9, epd_bitmap_splash_puro_pixel, 128, 64, 0);
+    } },
+    { "page_bitmap_modes", [](puroPixel_SSD1306& d) {
+        d.drawFillRect(0, 0, 64, 64);
+        d.drawPageBitmap(-32, 3, epd_pages_splash_puro_pixel, 128, 64, BLIT_XOR);
+        d.drawPageBitmap(70, -5, epd_pages_splash_puro_pixel, 40, 30, BLIT_OPAQUE);
+        d.drawPageBitmap(70, 35, epd_pages_splash_puro_pixel, 40, 29, BLIT_TRANSPARENT);
+    } },
+    { "fill_rects", [](puroPixel_SSD1306& d) {
+        for (int i = 0; i < 12; i++) d.drawFillRect(i * 11 - 3, (i * 7) % 50 - 2, 9 + i % 4, 5 + i, i % 3 != 0);
+        d.drawRect(2, 2, 123, 59);
+        d.drawFillRect(60, 20, 0, 10); // no area, only the outline lines
+    } },
+    { "fill_circles", [](puroPixel_SSD1306& d) {
+        d.drawFillCircle(20, 20, 8);
+        d.drawFillCircle(100, 10, 14);
+        d.drawFillCircle(70, 50, 20, 1);
+        d.drawFillCircle(-3, 60, 9);
+    } },
+    { "shapes", [](puroPixel_SSD1306& d) {
+        d.drawCircle(20, 20, 18);
+        d.drawFillCircle(20, 20, 8);
+        d.drawEllipse(64, 32, 30, 12);
+        d.drawFillEllipse(64, 32, 10, 20, 1);
+        d.drawArc(105, 20, 16, 45, 300);
+        d.drawRoundRect(85, 40, 40, 22, 6);
+        d.drawFillRoundRect(4, 44, 30, 18, 5);
+    } },
+    { "clip", [](puroPixel_SSD1306& d) {
+        d.pushClip(10, 10, 50, 30);
+        d.drawFillCircle(25, 15, 30);
+        d.drawString(0, 0, "clipped", 2, 0);
+        d.popClip();
+        d.pushClip(70, 5, 50, 50);
+        d.drawRoundRect(-5, -5, 40, 40, 8);
+        d.drawBitmap(10, 10, epd_bitmap_splash_puro_pixel, 128, 64);
+        d.popClip();
+    } },
+};
+
+static void busyScreen(puroPixel_SSD1306& d, int frame) {
+    char text[24];
+    d.clear();
+    d.drawRoundRect(0, 0, 128, 64, 5);
+    snprintf(text, sizeof(text), "frame %d", frame);
+    d.drawString(6, 5, text);
+    d.drawString(6, 20, "42.7", 3);
+    d.drawFillRect(6, 50, frame % 100, 8);
+    d.drawArc(104, 32, 18, 0, frame % 360);
+    d.drawPageBitmap(80, 8, epd_pages_splash_puro_pixel, 16, 16);
+}
+
+int main(int argc, char** argv) {
+    const char* save = nullptr;
+    const char* check = nullptr;
+    const char* diff = nullptr;
+    const char* streamPath = nullptr;
+    long frames = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--save")) save = argv[i + 1];
+        else if (!strcmp(argv[i], "--check")) check = argv[i + 1];
+        else if (!strcmp(argv[i], "--diff")) diff = argv[i + 1];
+        else if (!strcmp(argv[i], "--bench")) frames = atol(argv[i + 1]);
+        else if (!strcmp(argv[i], "--stream")) streamPath = argv[i + 1];
+    }
+    if (save == nullptr && check == nullptr && frames <= 0) {
+        fprintf(stderr, "usage: %s --save DIR | --check DIR [--diff DIR] | --bench N [--stream FILE]\n", argv[0]);
+        return 1;
+    }
+
+    puroPixel_SSD1306 display(0x3C, 128, 64, &Wire, true);
+    puroPixel_Capture capture(1);
+    capture.attach(display); // headless
+    display.begin();
+    int failed = 0;
+
+    for (const Scene& scene : scenes) {
+        if (save == nullptr && check == nullptr) break;
+        display.clear();
+        scene.draw(display);
+        display.update();
+
+        std::string name = std::string("/") + scene.name + ".pbm";
+        if (save != nullptr) {
+            if (!capture.savePbm((save + name).c_str())) {
+                fprintf(stderr, "can't write %s%s\n", save, name.c_str());
+                return 1;
+            }
+            continue;
+        }
+        std::string diffPath = diff != nullptr ? diff + name : "";
+        long changed = capture.compare((check + name).c_str(), diff != nullptr ? diffPath.c_str() : nullptr);
+        if (changed < 0) printf("%-20s no golden\n", scene.name);
+        else if (changed > 0) printf("%-20s %ld pixels differ\n", scene.name, changed);
+        else printf("%-20s ok\n", scene.name);
+        failed += changed != 0;
+    }
+
+    if (frames > 0) {
+        if (streamPath != nullptr && !capture.openStream(streamPath)) {
+            fprintf(stderr, "can't write %s\n", streamPath);
+            return 1;
+        }
+        uint32_t before = capture.getCount();
+        auto start = std::chrono::steady_clock::now();
+        for (long frame = 0; frame < frames; frame++) {
+            busyScreen(display, frame);
+            display.update();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        capture.closeStream();
+        printf("%lu frames in %.3f s: %.0f frames/s, %.1f us per frame%s\n", (unsigned long)(capture.getCount() - before),
+            seconds, frames / seconds, seconds * 1e6 / frames, streamPath != nullptr ? " (with the stream file)" : "");
+    }
+    return failed != 0;
+}
@@ -0,0 +1,68 @@
+// Differential check between two versions of the library: draws 20000 random primitives (no clip set) and prints a
+// hash of the buffer after each one, on 128x64, 96x16 and 64x48. Build it once with each version's library files and
+// diff the outputs. The first line that differs names the op and primitive that changed a pixel.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/hash_ops.cpp -pthread -o hash_ops
+// Usage: ./hash_ops > new.txt, then the same with the other version's *.cpp and ssd1306.h, then diff
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "check.h"
+
+static uint32_t hashBuffer(const unsigned char* buffer, size_t size) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash ^= buffer[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void run(uint8_t w, uint8_t h) {
+    static const char* texts[] = { "Hi", "Hello, SSD1306!", "a\nb c", "~}|{", "", " x " };
+    static textRun runs[3] = {};
+    puroPixel_SSD1306 display(0x3C, w, h, &Wire, true); // never updated, nothing goes to the bus
+    display.clear();
+    checkSeed = 12345;
+
+    for (int op = 0; op < 20000; op++) {
+        int kind = checkRandom(0, 16), x = checkRandom(-20, w + 20), y = checkRandom(-15, h + 15);
+        int a = checkRandom(-5, 44), b = checkRandom(-5, 44), color = checkRandom(0, 1);
+        switch (kind) {
+        case 0: display.drawPixel(x, y, color); break;
+        case 1: display.drawHorLine(x, y, a, color); break;
+        case 2: display.drawVerLine(x, y, a, color); break;
+        case 3: display.drawRect(x, y, a, b, color); break;
+        case 4: display.drawFillRect(x, y, a, b, color); break;
+        case 5: display.drawString(x, y, texts[checkRandom(0, 5)], checkRandom(1, 6), color, checkRandom(0, 1), checkRandom(0, 1)); break;
+        case 6: display.drawBitmap(x, y, epd_bitmap_splash_puro_pixel, 128, 64, color); break;
+        case 7: display.drawFillCircle(x, y, checkRandom(0, 19), color); break;
+        case 8: if (checkRandom(0, 19) == 0) display.fillScreen(color); break;
+        case 9: if (checkRandom(0, 19) == 0) display.invert(); break;
+        case 10: if (checkRandom(0, 49) == 0) display.clear(); break;
+        case 11: display.drawCircle(x, y, checkRandom(0, 29), 0, color); break;
+        case 12:
+            if (checkRandom(0, 1)) display.drawEllipse(x, y, checkRandom(0, 29), checkRandom(0, 19), color);
+            else display.drawFillEllipse(x, y, checkRandom(0, 29), checkRandom(0, 19), color);
+            break;
+        case 13: display.drawArc(x, y, checkRandom(0, 29), checkRandom(-360, 359), checkRandom(-360, 359), color); break;
+        case 14:
+            if (checkRandom(0, 1)) display.drawRoundRect(x, y, a, b, checkRandom(0, 11), color);
+            else display.drawFillRoundRect(x, y, a, b, checkRandom(0, 11), color);
+            break;
+        case 15:
+            display.drawPageBitmap(x, y, epd_bitmap_splash_puro_pixel + checkRandom(0, 63), checkRandom(1, 60), checkRandom(1, 40),
+                (BlitMode)checkRandom(0, 2), color);
+            break;
+        case 16: display.drawStringCached(runs[checkRandom(0, 2)], x, y, checkRandom(0, 1) ? "ab" : "xyz", checkRandom(1, 3), color, checkRandom(0, 1)); break;
+        }
+        printf("%dx%d %d %d %08x\n", w, h, op, kind, hashBuffer(display.getBuffer(), w * h / 8));
+    }
+}
+
+int main() {
+    run(128, 64);
+    run(96, 16);
+    run(64, 48);
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include "Arduino.h"
+#include "wire.h"
+#include "SPI.h"
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+TwoWire Wire;
+SPIClass SPI;
+
+static const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static uint8_t pinLevels[256];
+
+void pinMode(uint8_t, uint8_t) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    pinLevels[pin] = value != LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pinLevels[pin];
+}
+
+void HostSerial::begin(unsigned long) {
+}
+
+size_t HostSerial::print(const char* str) {
+    return printf("%s", str);
+}
+
+size_t HostSerial::print(int value, int base) {
+    return printf(base == HEX ? "%X" : "%d", value);
+}
+
+size_t HostSerial::println(const char* str) {
+    return printf("%s\n", str);
+}
+
+size_t HostSerial::println(int value, int base) {
+    return printf(base == HEX ? "%X\n" : "%d\n", value);
+}
+
+TwoWire::TwoWire() {
+    clock = 100000;
+    open = false;
+    repeated = false;
+    recording = false;
+    resetStats();
+}
+
+bool TwoWire::begin(int, int, uint32_t frequency) {
+    if (frequency != 0) clock = frequency;
+    return true;
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+    clock = frequency;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    open = true;
+    current.address = address;
+    current.bytes.clear();
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (!open) return 0;
+    current.bytes.push_back(data);
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+    if (!open) return 0;
+    current.bytes.insert(current.bytes.end(), data, data + quantity);
+    return quantity;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    if (!open) return 4;
+    open = false;
+
+    stats.transactions++;
+    if (repeated) {
+        stats.repeatedStarts++;
+    }
+    else {
+        stats.starts++;
+    }
+    if (sendStop) stats.stops++;
+    repeated = !sendStop;
+
+    stats.bytes += 1 + current.bytes.size(); // address byte + payload
+    if (current.bytes.size() > I2C_BUFFER_LENGTH) stats.overflows++;
+    if (!current.bytes.empty()) {
+        uint32_t payload = current.bytes.size() - 1;
+        if (current.bytes[0] == 0x00) {
+            stats.controlCommand++;
+            stats.commandBytes += payload;
+        }
+        else if (current.bytes[0] == 0x40) {
+            stats.controlData++;
+            stats.dataBytes += payload;
+        }
+    }
+
+    current.stop = sendStop;
+    if (recording) log.push_back(current);
+    return 0;
+}
+
+void TwoWire::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+    log.clear();
+}
+
+const WireStats& TwoWire::getStats() const {
+    return stats;
+}
+
+void TwoWire::setRecording(bool enable) {
+    recording = enable;
+}
+
+const std::vector<WireTransaction>& TwoWire::getLog() const {
+    return log;
+}
+
+// Every byte is 8 data clocks + the ACK clock. The start/stop conditions cost the setup/hold/bus-free times
+// from the I2C spec (UM10204, table 10) of the speed mode the frequency falls in.
+double TwoWire::estimateMicros(uint32_t frequency) const {
+    double tHdSta, tSuSta, tSuSto, tBuf; // microseconds
+    if (frequency <= 100000) {
+        tHdSta = 4.0; tSuSta = 4.7; tSuSto = 4.0; tBuf = 4.7;   // standard mode
+    }
+    else if (frequency <= 400000) {
+        tHdSta = 0.6; tSuSta = 0.6; tSuSto = 0.6; tBuf = 1.3;   // fast mode
+    }
+    else {
+        tHdSta = 0.26; tSuSta = 0.26; tSuSto = 0.26; tBuf = 0.5; // fast mode plus
+    }
+
+    double bits = stats.bytes * 9.0;
+    return bits * 1000000.0 / frequency
+        + stats.starts * tHdSta
+        + stats.repeatedStarts * (tSuSta + tHdSta)
+        + stats.stops * (tSuSto + tBuf);
+}
+
+double TwoWire::estimateMicros() const {
+    return estimateMicros(clock);
+}
+
+SPIClass::SPIClass() {
+    fresh = true;
+    recording = false;
+    dc = -1;
+    resetStats();
+}
+
+void SPIClass::begin(int8_t, int8_t, int8_t, int8_t) {
+}
+
+void SPIClass::beginTransaction(SPISettings s) {
+    fresh = true;
+    settings = s;
+    stats.transactions++;
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+    writeBytes(&data, 1);
+    return 0;
+}
+
+void SPIClass::writeBytes(const uint8_t* data, uint32_t size) {
+    bool isData = dc >= 0 && digitalRead(dc) == HIGH;
+    stats.bytes += size;
+    if (isData) stats.dataBytes += size;
+    else stats.commandBytes += size;
+    clocks += size * 8.0 / settings.clock;
+    if (!recording) return;
+
+    // bytes of the same transaction with the same D/C level are one entry
+    if (log.empty() || fresh || log.back().dc != isData) {
+        log.push_back(SPITransfer { isData, settings.clock, std::vector<uint8_t>() });
+    }
+    log.back().bytes.insert(log.back().bytes.end(), data, data + size);
+    fresh = false;
+}
+
+void SPIClass::endTransaction() {
+    fresh = true;
+}
+
+void SPIClass::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+    clocks = 0;
+    log.clear();
+}
+
+const SPIStats& SPIClass::getStats() const {
+    return stats;
+}
+
+void SPIClass::setRecording(bool enable, int8_t dcPin) {
+    recording = enable;
+    dc = dcPin;
+}
+
+const std::vector<SPITransfer>& SPIClass::getLog() const {
+    return log;
+}
+
+double SPIClass::estimateMicros(double csMicros) const {
+    return clocks * 1000000.0 + stats.transactions * csMicros;
+}
@@ -0,0 +1,126 @@
+#ifndef PUROPIXEL_HOST_MOCKTRANSPORT_H__
+#define PUROPIXEL_HOST_MOCKTRANSPORT_H__
+
+// Transport for host tests: keeps what the display sent and plays it into a model of the panel memory
+// (horizontal addressing with the PAGEADDR/COLUMNADDR window, content scroll, start line), so a test can check
+// what would really be on screen.
+
+#include "ssd1306.h"
+#include <vector>
+#include <algorithm>
+
+struct mockTransfer {
+    bool isData;
+    std::vector<uint8_t> bytes;
+};
+
+class puroPixel_MockTransport : public puroPixel_Transport {
+public:
+    puroPixel_MockTransport(uint8_t w = 128, uint8_t h = 64) : width(w), pages(h / 8), gddram(w * (h / 8), 0) {}
+
+    bool begin() {
+        begins++;
+        return true;
+    }
+
+    void commands(const uint8_t* cmds, uint16_t len) {
+        record(false, cmds, len);
+        for (uint16_t i = 0; i < len; i++) {
+            // a command and its arguments may be split over several calls, like on the real bus
+            if (pendingLen == 0) pendingNeed = 1 + argumentCount(cmds[i]);
+            pending[pendingLen++] = cmds[i];
+            if (pendingLen == pendingNeed) {
+                execute(pending);
+                pendingLen = 0;
+            }
+        }
+    }
+
+    void data(const uint8_t* bytes, uint16_t len) {
+        record(true, bytes, len);
+        for (uint16_t i = 0; i < len; i++) {
+            if (page[2] < pages && col[2] < width) gddram[page[2] * width + col[2]] = bytes[i];
+            if (++col[2] > col[1]) {
+                col[2] = col[0];
+                if (++page[2] > page[1]) page[2] = page[0];
+            }
+        }
+    }
+
+    // the panel memory, in the same page order as the display buffer
+    const std::vector<uint8_t>& getMemory() const { return gddram; }
+    uint8_t getStartLine() const { return startLine; }
+    uint32_t getBegins() const { return begins; }
+    const std::vector<mockTransfer>& getLog() const { return log; }
+    void clearLog() { log.clear(); }
+private:
+    uint8_t width, pages;
+    std::vector<uint8_t> gddram;
+    uint8_t col[3] = { 0, 127, 0 }; // start, end, pointer
+    uint8_t page[3] = { 0, 7, 0 };
+    uint8_t startLine = 0;
+    uint32_t begins = 0;
+    std::vector<mockTransfer> log;
+    uint8_t pending[7]; // opcode + arguments of the command being received
+    uint8_t pendingLen = 0, pendingNeed = 0;
+
+    static uint8_t argumentCount(uint8_t c) {
+        switch (c) {
+        case SSD1306_COLUMNADDR:
+        case SSD1306_PAGEADDR:
+        case SSD1306_SET_VERTICAL_SCROLL_AREA:
+            return 2;
+        case SSD1306_RIGHT_HORIZONTAL_SCROLL:
+        case SSD1306_LEFT_HORIZONTAL_SCROLL:
+        case SSD1306_CONTENT_SCROLL_RIGHT:
+        case SSD1306_CONTENT_SCROLL_LEFT:
+            return 6;
+        case SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL:
+        case SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL:
+            return 5;
+        case SSD1306_MEMORYMODE:
+        case SSD1306_SETCONTRAST:
+        case SSD1306_CHARGEPUMP:
+        case SSD1306_SETMULTIPLEX:
+        case SSD1306_SETDISPLAYOFFSET:
+        case SSD1306_SETDISPLAYCLOCKDIV:
+        case SSD1306_SETPRECHARGE:
+        case SSD1306_SETCOMPINS:
+        case SSD1306_SETVCOMDETECT:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+    // only what changes the memory or the start line is modelled, the continuous scrolls (0x26/0x27/0x29/0x2A)
+    // depend on time and are only parsed
+    void execute(const uint8_t* c) {
+        if (c[0] == SSD1306_COLUMNADDR || c[0] == SSD1306_PAGEADDR) {
+            uint8_t* window = c[0] == SSD1306_COLUMNADDR ? col : page;
+            window[0] = c[1];
+            window[1] = c[2];
+            window[2] = c[1]; // the pointer goes back to the start of the window
+        }
+        else if (c[0] == SSD1306_CONTENT_SCROLL_RIGHT || c[0] == SSD1306_CONTENT_SCROLL_LEFT) {
+            // one column step of pages c[2]..c[4], columns c[5]..c[6], the column pushed out comes back on the other side
+            uint8_t end = c[6] < width ? c[6] : width - 1;
+            for (uint8_t p = c[2]; p <= c[4] && p < pages && c[5] < end; p++) {
+                uint8_t* row = &gddram[p * width];
+                if (c[0] == SSD1306_CONTENT_SCROLL_LEFT) std::rotate(row + c[5], row + c[5] + 1, row + end + 1);
+                else std::rotate(row + c[5], row + end, row + end + 1);
+            }
+        }
+        else if (c[0] >= SSD1306_SETSTARTLINE && c[0] <= SSD1306_SETSTARTLINE + 63) {
+            startLine = c[0] - SSD1306_SETSTARTLINE;
+        }
+    }
+
+    void record(bool isData, const uint8_t* bytes, uint16_t len) {
+        log.push_back(mockTransfer { isData, std::vector<uint8_t>(bytes, bytes + len) });
+        this->bytes += len;
+        transactions++;
+    }
+};
+
+#endif
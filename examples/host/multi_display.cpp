@@ -0,0 +1,70 @@
+// Two panels on one bus: 0x3C redraws the whole screen every frame, 0x3D only changes a counter.
+// Compares how long the small change waits for the bus with back-to-back update() calls and with puroPixel_DisplayBus.
+// Build: g++ -std=gnu++11 -O2 -I examples/host -I . *.cpp examples/host/host.cpp examples/host/multi_display.cpp -pthread -o multi_display
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "ssd1306.h"
+#include "displaybus.h"
+
+static const uint32_t FREQ = 400000;
+static const int FRAMES = 50;
+
+static void drawFrame(puroPixel_SSD1306& big, puroPixel_SSD1306& small, int frame) {
+    big.fillScreen(frame & 1); // worst case, 1 KiB every frame
+    char text[12];
+    snprintf(text, sizeof(text), "%d", frame);
+    small.drawString(0, 0, text, 2, 1, true);
+}
+
+int main() {
+    puroPixel_SSD1306 big(0x3C, 128, 64, &Wire, true);
+    puroPixel_SSD1306 small(0x3D, 128, 32, &Wire, true);
+    Wire.begin();
+    big.begin();
+    small.begin();
+
+    // back to back: the counter always waits for the whole big frame
+    double worst = 0, total = 0;
+    Wire.resetStats();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        drawFrame(big, small, frame);
+        double before = Wire.estimateMicros(FREQ);
+        big.update();
+        small.update();
+        double wait = Wire.estimateMicros(FREQ) - before;
+        total += wait;
+        if (wait > worst) worst = wait;
+    }
+    printf("update() x2        counter latency avg %8.1f us  max %8.1f us  (bus time @400k)\n", total / FRAMES, worst);
+
+    // bus manager: the counter has priority, the big frame is sent in between, 2 ms of bus per service()
+    puroPixel_DisplayBus bus;
+    int8_t bigId = bus.add(&big, 0);
+    int8_t smallId = bus.add(&small, 2);
+    bus.setFrameBudget(2000 / 23); // ~23 us per byte at 400 kHz
+    worst = 0;
+    total = 0;
+    int services = 0;
+    Wire.resetStats();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        drawFrame(big, small, frame);
+        bus.update(bigId);
+        bus.update(smallId);
+        double before = Wire.estimateMicros(FREQ);
+        while (bus.isPending(smallId)) {
+            bus.service();
+            services++;
+        }
+        double wait = Wire.estimateMicros(FREQ) - before;
+        total += wait;
+        if (wait > worst) worst = wait;
+        while (bus.service()) services++; // the rest of the big frame, your loop() would do other work between these
+    }
+    printf("puroPixel_DisplayBus counter latency avg %8.1f us  max %8.1f us  (%d service() calls)\n", total / FRAMES, worst, services);
+
+    busDisplayStats bs = bus.getStats(bigId);
+    busDisplayStats ss = bus.getStats(smallId);
+    printf("big:   %u frames %6u bytes\nsmall: %u frames %6u bytes\n", bs.frames, bs.bytes, ss.frames, ss.bytes);
+    return bs.frames != FRAMES || ss.frames != FRAMES || Wire.getStats().overflows != 0;
+}
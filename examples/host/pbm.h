@@ -0,0 +1,95 @@
+#ifndef PUROPIXEL_HOST_PBM_H__
+#define PUROPIXEL_HOST_PBM_H__
+
+// PBM / raw bitmap reading shared by the host converters (pbm2c, anim2c).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <vector>
+
+static inline std::vector<unsigned char> readFile(const char* path) {
+    std::vector<unsigned char> data;
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return data;
+    unsigned char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) data.insert(data.end(), chunk, chunk + n);
+    fclose(file);
+    return data;
+}
+
+// next whitespace separated token of the PBM header, comments skipped
+static inline bool headerNumber(const std::vector<unsigned char>& data, size_t& pos, int& value) {
+    for (;;) {
+        while (pos < data.size() && isspace(data[pos])) pos++;
+        if (pos < data.size() && data[pos] == '#') {
+            while (pos < data.size() && data[pos] != '\n') pos++;
+            continue;
+        }
+        break;
+    }
+    if (pos >= data.size() || !isdigit(data[pos])) return false;
+    value = 0;
+    while (pos < data.size() && isdigit(data[pos])) value = value * 10 + (data[pos++] - '0');
+    return true;
+}
+
+// pixels[y * w + x] = 1 for a lit pixel
+static inline bool decodePbm(const std::vector<unsigned char>& data, int& w, int& h, std::vector<unsigned char>& pixels) {
+    if (data.size() < 2 || data[0] != 'P' || (data[1] != '1' && data[1] != '4')) return false;
+    size_t pos = 2;
+    if (!headerNumber(data, pos, w) || !headerNumber(data, pos, h) || w <= 0 || h <= 0) return false;
+    pixels.assign(w * h, 0);
+
+    if (data[1] == '1') {
+        for (int i = 0; i < w * h; i++) {
+            while (pos < data.size() && data[pos] != '0' && data[pos] != '1') pos++;
+            if (pos >= data.size()) return false;
+            pixels[i] = data[pos++] == '1';
+        }
+        return true;
+    }
+
+    pos++; // single whitespace after the height
+    int rowBytes = (w + 7) / 8;
+    if (data.size() < pos + (size_t)rowBytes * h) return false;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            pixels[y * w + x] = (data[pos + y * rowBytes + x / 8] >> (7 - (x & 7))) & 1;
+        }
+    }
+    return true;
+}
+
+static inline bool decodeRaw(const std::vector<unsigned char>& data, int w, int h, std::vector<unsigned char>& pixels) {
+    int rowBytes = (w + 7) / 8;
+    if (w <= 0 || h <= 0 || data.size() < (size_t)rowBytes * h) return false;
+    pixels.assign(w * h, 0);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            pixels[y * w + x] = (data[y * rowBytes + x / 8] >> (7 - (x & 7))) & 1;
+        }
+    }
+    return true;
+}
+
+// pixels (1 = lit) to SSD1306 page order: (h + 7) / 8 pages of w bytes, bit 0 on top
+static inline std::vector<unsigned char> toPages(const std::vector<unsigned char>& pixels, int w, int h, bool invert) {
+    int pages = (h + 7) / 8;
+    std::vector<unsigned char> out(pages * w, 0);
+    for (int page = 0; page < pages; page++) {
+        for (int x = 0; x < w; x++) {
+            unsigned char b = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                int y = page * 8 + bit;
+                if (y < h && (pixels[y * w + x] != 0) != invert) b |= 1 << bit;
+            }
+            out[page * w + x] = b;
+        }
+    }
+    return out;
+}
+
+#endif
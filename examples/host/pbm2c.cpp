@@ -0,0 +1,51 @@
+// Converts an image to a C header in the SSD1306 page order, ready for drawPageBitmap().
+// Build: g++ -std=gnu++11 -O2 examples/host/pbm2c.cpp -o pbm2c
+// Usage: ./pbm2c [--name NAME] [--invert] image.pbm > image.h
+//        ./pbm2c [--name NAME] [--invert] --raw W H image.bin > image.h
+// PBM: P1 (text) or P4 (binary), a 1 (black) pixel becomes a lit pixel, --invert flips that.
+// Raw: rows of (W + 7) / 8 bytes, MSB first, the format drawBitmap() takes (like epd_bitmap_splash_puro_pixel).
+
+#include "pbm.h"
+
+int main(int argc, char** argv) {
+    const char* name = "bitmap";
+    const char* input = nullptr;
+    bool invert = false;
+    bool raw = false;
+    int w = 0, h = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--name") && i + 1 < argc) name = argv[++i];
+        else if (!strcmp(argv[i], "--invert")) invert = true;
+        else if (!strcmp(argv[i], "--raw") && i + 2 < argc) {
+            raw = true;
+            w = atoi(argv[++i]);
+            h = atoi(argv[++i]);
+        }
+        else if (input == nullptr && argv[i][0] != '-') input = argv[i];
+        else input = nullptr, i = argc;
+    }
+    if (input == nullptr) {
+        fprintf(stderr, "usage: %s [--name NAME] [--invert] [--raw W H] input > output.h\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<unsigned char> data = readFile(input);
+    std::vector<unsigned char> pixels;
+    if (!(raw ? decodeRaw(data, w, h, pixels) : decodePbm(data, w, h, pixels))) {
+        fprintf(stderr, "%s: can't read %s\n", argv[0], input);
+        return 1;
+    }
+
+    int pages = (h + 7) / 8;
+    std::vector<unsigned char> bytes = toPages(pixels, w, h, invert);
+    printf("// '%s', %dx%dpx, SSD1306 page order: drawPageBitmap(x, y, %s, %d, %d)\n", name, w, h, name, w, h);
+    printf("const unsigned char %s[] PROGMEM = {", name);
+    for (size_t index = 0; index < bytes.size(); index++) {
+        printf("%s%s0x%02x", index ? "," : "", (index % 16) ? " " : "\n    ", bytes[index]);
+    }
+    printf("\n};\n");
+
+    fprintf(stderr, "%s: %dx%d -> %d bytes\n", name, w, h, pages * w);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef PUROPIXEL_HOST_WIRE_H__
+#define PUROPIXEL_HOST_WIRE_H__
+
+// Stand-in TwoWire for host builds. Nothing is sent anywhere: every transaction is counted (and optionally
+// recorded byte by byte) and the time it would take on a real bus is estimated with a bit-level I2C model.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#define I2C_BUFFER_LENGTH 128 // same TX buffer as the ESP32 core
+
+struct WireTransaction {
+    uint8_t address;
+    bool stop;                  // false for endTransmission(false), next one starts with a repeated start
+    std::vector<uint8_t> bytes; // payload, the first one is the SSD1306 control byte
+};
+
+struct WireStats {
+    uint32_t transactions;
+    uint32_t starts;        // start conditions
+    uint32_t repeatedStarts; // repeated starts, after endTransmission(false)
+    uint32_t stops;
+    uint32_t bytes;         // everything on the wire, address bytes included
+    uint32_t commandBytes;  // payload after a 0x00 control byte
+    uint32_t dataBytes;     // payload after a 0x40 control byte
+    uint32_t controlCommand; // transactions with a 0x00 control byte
+    uint32_t controlData;    // transactions with a 0x40 control byte
+    uint32_t overflows;      // transactions bigger than I2C_BUFFER_LENGTH, a real core would have truncated them
+};
+
+class TwoWire {
+public:
+    TwoWire();
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    void setClock(uint32_t frequency);
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t quantity);
+    uint8_t endTransmission(bool sendStop = true);
+
+    // recorder
+    void resetStats();
+    const WireStats& getStats() const;
+    void setRecording(bool enable);
+    const std::vector<WireTransaction>& getLog() const;
+
+    // bus cost model
+    double estimateMicros(uint32_t frequency) const;
+    double estimateMicros() const; // at the setClock() frequency
+private:
+    uint32_t clock;
+    bool open;
+    bool repeated; // last transaction ended without a stop
+    bool recording;
+    WireTransaction current;
+    WireStats stats;
+    std::vector<WireTransaction> log;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -1,20 +1,101 @@
 #include "ssd1306.h"
 #include "font.h"
+#include "bufops.h"
+
+#if defined(SSD1306_ASYNC_FREERTOS)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+struct puroPixel_AsyncWorker {
+    TaskHandle_t task;
+    SemaphoreHandle_t start; // given by updateAsync(), one per frame
+    SemaphoreHandle_t done;  // given by the worker after each frame
+    volatile bool busy;
+    volatile bool stop;
+};
+#elif defined(SSD1306_ASYNC_THREAD)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+struct puroPixel_AsyncWorker {
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable signal;
+    bool busy;
+    bool stop;
+};
+#else
+struct puroPixel_AsyncWorker {}; // no backend, updateAsync() is a plain update()
+#endif
+
+// Glyphs at scale 2-4 from the display's own cache, least recently used entry goes first. Horizontal
+// scaling is just repeating the column, so it isn't stored.
+const uint32_t* puroPixel_SSD1306::scaledGlyph(char character, uint8_t scale) {
+    if (glyphCache == nullptr) {
+        // first scaled text on a heap display, the static one brings its own entries
+        owned_glyphs = new glyphCacheEntry[SSD1306_GLYPH_CACHE_SIZE]();
+        glyphCache = owned_glyphs;
+        glyphCacheSize = SSD1306_GLYPH_CACHE_SIZE;
+    }
+    uint8_t oldest = 0;
+    for (uint8_t i = 0; i < glyphCacheSize; i++) {
+        if (glyphCache[i].scale == scale && glyphCache[i].character == character) {
+            glyphCache[i].used = ++glyphClock;
+            return glyphCache[i].cols;
+        }
+        if (glyphCache[i].used < glyphCache[oldest].used) oldest = i;
+    }
+
+    glyphCacheEntry& entry = glyphCache[oldest];
+    const char* charF = ASCII[character - 0x20];
+    uint32_t block = (1UL << scale) - 1;
+    for (uint8_t cx = 0; cx < 5; cx++) {
+        uint32_t bits = 0;
+        for (uint8_t j = 0; j < 7; j++) {
+            if ((charF[cx] >> j) & 1) bits |= block << (j * scale);
+        }
+        entry.cols[cx] = bits;
+    }
+    entry.character = character;
+    entry.scale = scale;
+    entry.used = ++glyphClock;
+    return entry.cols;
+}
 
 int lerp(int valor, int in_min, int in_max, int out_min, int out_max) {
     return (valor - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
 
-bool puroPixel_SSD1306::checkI2CDevice(uint8_t address) {
-    Wire.beginTransmission(address);
-    return Wire.endTransmission();
+bool puroPixel_SSD1306::checkI2CDevice() {
+    if (headless) return true;
+    return transport->probe();
 }
 
 void puroPixel_SSD1306::transmit_command(unsigned char c) {
-    wire->beginTransmission(address);
-    wire->write(0x00); // bit 7 is 0 for Co bit (data bytes only), bit 6 is 0 for DC (data is a command))
-    wire->write(c);
-    wire->endTransmission();
+    transmit_commands(&c, 1);
+}
+
+// everything goes through the transport: commands in one burst per list (an I2C transport splits what doesn't
+// fit the TX buffer), then GDDRAM data
+void puroPixel_SSD1306::transmit_commands(const unsigned char* cmds, uint8_t len) {
+    if (headless) return;
+    SSD1306_STAT(uint32_t bytes = transport->getBytes());
+    SSD1306_STAT(uint32_t transactions = transport->getTransactions());
+    transport->commands(cmds, len);
+    SSD1306_STAT(stats.busBytes += transport->getBytes() - bytes);
+    SSD1306_STAT(stats.transactions += transport->getTransactions() - transactions);
+}
+
+void puroPixel_SSD1306::transmit_data(const unsigned char* data, uint16_t len) {
+    if (headless) return;
+    SSD1306_STAT(uint32_t bytes = transport->getBytes());
+    SSD1306_STAT(uint32_t transactions = transport->getTransactions());
+    transport->data(data, len);
+    SSD1306_STAT(stats.busBytes += transport->getBytes() - bytes);
+    SSD1306_STAT(stats.transactions += transport->getTransactions() - transactions);
+    SSD1306_STAT(stats.dataBytes += len);
 }
 
 /*!
@@ -32,13 +113,60 @@ void puroPixel_SSD1306::transmit_command(unsigned char c) {
 @param ns
     no splash screen, set to true to disable it. :(
 */
-puroPixel_SSD1306::puroPixel_SSD1306(uint8_t addr, uint8_t w, uint8_t h, TwoWire* i2c, bool ns) {
+puroPixel_SSD1306::puroPixel_SSD1306(uint8_t addr, uint8_t w, uint8_t h, TwoWire* i2c, bool ns) : i2cTransport(i2c, addr) {
     width = w;
     height = h;
-    wire = i2c;
-    address = addr;
+    transport = &i2cTransport;
     noSplash = ns;
     ssd1306_buffer = new unsigned char[width * (height / 8)];
+    owned_buffer = ssd1306_buffer;
+    resetClip();
+    invalidate();
+}
+
+/*!
+@brief creates a display on another bus, like 4-wire SPI: puroPixel_SPITransport spi(&SPI, DC_PIN, CS_PIN, RST_PIN); puroPixel_SSD1306 display(&spi, 128, 64);
+@param t
+    the transport, it has to live as long as the display. With nullptr nothing is sent until setTransport() gets a real one.
+@param w
+    width of the display.
+@param h
+    height of the display.
+@param ns
+    no splash screen, set to true to disable it.
+*/
+puroPixel_SSD1306::puroPixel_SSD1306(puroPixel_Transport* t, uint8_t w, uint8_t h, bool ns) {
+    width = w;
+    height = h;
+    transport = t != nullptr ? t : &i2cTransport; // the I2C transport without a TwoWire drops everything
+    noSplash = ns;
+    ssd1306_buffer = new unsigned char[width * (height / 8)];
+    owned_buffer = ssd1306_buffer;
+    resetClip();
+    invalidate();
+}
+
+// used by puroPixel_SSD1306_Static: the buffer, the glyph cache and the init table come from the template, nothing is allocated
+puroPixel_SSD1306::puroPixel_SSD1306(uint8_t addr, uint8_t w, uint8_t h, TwoWire* i2c, bool ns, unsigned char* buffer, glyphCacheEntry* glyphs, uint8_t glyphCount, const unsigned char* init, uint8_t initLen) : i2cTransport(i2c, addr) {
+    width = w;
+    height = h;
+    transport = &i2cTransport;
+    noSplash = ns;
+    ssd1306_buffer = buffer;
+    owned_buffer = nullptr;
+    glyphCache = glyphs;
+    glyphCacheSize = glyphCount;
+    initSequence = init;
+    initLength = initLen;
+    resetClip();
+    invalidate();
+}
+
+puroPixel_SSD1306::~puroPixel_SSD1306() {
+    endAsync();
+    delete[] owned_buffer;
+    delete[] shadow_buffer;
+    delete[] owned_glyphs;
 }
 
 
@@ -47,32 +175,606 @@ puroPixel_SSD1306::puroPixel_SSD1306(uint8_t addr, uint8_t w, uint8_t h, TwoWire
 @note   after use, call update(). To applay effects.
 */
 void puroPixel_SSD1306::clear() {
-    memset(ssd1306_buffer, 0, 1024); // make every bit a 0, memset in string.h
+    SSD1306_STAT(countCall(STAT_SCREEN));
+    SSD1306_STAT(stats.pixels += width * height);
+    ssd1306_fill(ssd1306_buffer, 0x00, width * (height / 8)); // make every bit a 0
+    markAllDirty();
+    generation++;
 }
 
 /*!
 @brief load the current buffer to your display. You call this function after a draw or a clear function. For example: drawPixel(...); update(); // loads buffer
+@note   only the column windows touched since the last update() are sent. Each window goes out in bursts as big as the TwoWire TX buffer allows (SSD1306_WIRE_MAX).
+    After setFramePeriod() it only marks the frame as waiting, tick() sends it.
 */
 void puroPixel_SSD1306::update() {
-    transmit_command(SSD1306_PAGEADDR);
-    transmit_command(0);
-    transmit_command(0xFF);
-    transmit_command(SSD1306_COLUMNADDR);
-    transmit_command(0);
-    transmit_command(width - 1);
-    for (unsigned char page = 0; page < 8; page++) {
-        transmit_command(0xB0 + page);    // Select the page to write to
-        for (unsigned char col = 0; col < width; col++) {
-            Wire.beginTransmission(address);
-            Wire.write(0x40);  // Send pixel data
-            Wire.write(ssd1306_buffer[col + (page * width)]);  // Send the data byte for this column
-            Wire.endTransmission();
+    if (framePeriod != 0) {
+        if (framePending) pacing.coalesced++;
+        else pendingSince = micros();
+        framePending = true;
+        pacing.requests++;
+        return;
+    }
+    sendFrame();
+}
+
+// the real update(): whatever is dirty goes out now, including a frame waiting for tick()
+void puroPixel_SSD1306::sendFrame() {
+    waitForFlush(); // never race the async worker for the bus
+    framePending = false;
+    pendingAsync = false;
+    splashPending = false; // this frame replaces the fastStart splash
+#ifdef SSD1306_ENABLE_STATS
+    if (!stepping) countFrame(dirtyLo, dirtyHi); // else flushStep() counted this frame already
+#endif
+    stepping = false;
+    uint32_t start = micros();
+
+    if (capture != nullptr) capture(ssd1306_buffer, width, height, captureCtx);
+    if (!headless) flush(ssd1306_buffer, dirtyLo, dirtyHi);
+    clearDirty();
+
+    lastUpdateMicros = micros() - start;
+    SSD1306_STAT(countLatency(stats.updateLatency, lastUpdateMicros));
+}
+
+// sends the dirty windows [lo, hi] of every page of src
+void puroPixel_SSD1306::flush(const unsigned char* src, const uint8_t* lo, const uint8_t* hi) {
+    uint8_t pages = height / 8;
+
+    for (uint8_t page = 0; page < pages; page++) {
+        if (lo[page] > hi[page]) continue;
+
+        if (shadowValid) {
+            sendPageDiff(src, page, lo[page], hi[page]);
+            continue;
         }
+
+        // pages with the same dirty columns go out as one window (a full redraw is a single window)
+        uint8_t last = page;
+        while (last + 1 < pages && lo[last + 1] == lo[page] && hi[last + 1] == hi[page]) {
+            last++;
+        }
+        sendWindow(src, page, last, lo[page], hi[page]);
+        page = last;
     }
+    transport->wait(); // a DMA transport may still be reading src
+    if (shadow_buffer != nullptr) shadowValid = true;
+}
+
+void puroPixel_SSD1306::sendWindow(const unsigned char* src, uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1) {
+    const unsigned char window[] = { SSD1306_PAGEADDR, page0, page1, SSD1306_COLUMNADDR, col0, col1 };
+    transmit_commands(window, sizeof(window));
+
+    uint8_t cols = col1 - col0 + 1;
+    if (shadow_buffer != nullptr) {
+        ssd1306_copyRegion(&shadow_buffer[page0 * width + col0], width, &src[page0 * width + col0], width, cols, page1 - page0 + 1);
+    }
+    if (col0 == 0 && cols == width) {
+        // full-width window, the pages are contiguous in the buffer so it is one stream
+        transmit_data(&src[page0 * width], cols * (page1 - page0 + 1));
+        return;
+    }
+    for (uint8_t page = page0; page <= page1; page++) {
+        transmit_data(&src[page * width + col0], cols);
+    }
+}
+
+// sends only the bytes of this page that differ from the shadow frame. Changed bytes closer than shadowGap
+// columns are merged into one window, a new window costs more on the bus than a few repeated bytes.
+void puroPixel_SSD1306::sendPageDiff(const unsigned char* src, uint8_t page, uint8_t col0, uint8_t col1) {
+    const unsigned char* cur = &src[page * width];
+    const unsigned char* old = &shadow_buffer[page * width];
+    int16_t runStart = -1;
+    int16_t runEnd = -1;
+
+    for (int16_t col = col0; col <= col1; col++) {
+        if (cur[col] == old[col]) continue;
+        if (runStart >= 0 && (col - runEnd - 1) > shadowGap) {
+            sendWindow(src, page, page, runStart, runEnd);
+            runStart = -1;
+        }
+        if (runStart < 0) runStart = col;
+        runEnd = col;
+    }
+    if (runStart >= 0) sendWindow(src, page, page, runStart, runEnd);
+}
+
+/*!
+@brief sends part of the pending changes: dirty columns from the top page down, at most budget bytes on the bus, and leaves the rest marked for later.
+    Made for puroPixel_DisplayBus, which shares one bus between several displays, but works on its own too (a long refresh spread over several loop() runs).
+@note   what you draw in between is picked up as well, but a frame split like this can be on the panel half old, half new for a moment.
+    The step that finishes the frame hands it to the frame capture (setFrameCapture()), and a frame waiting for tick() is then no longer pending.
+@param budget
+    bytes on the bus at most, window commands and control bytes included. Each window costs 6 command bytes plus the transport's
+    framing before its first data byte (9 bytes for one data byte on I2C), a budget too small for that sends nothing.
+@return bytes put on the bus. 0 when there was nothing to send or nothing fit.
+*/
+uint16_t puroPixel_SSD1306::flushStep(uint16_t budget) {
+    waitForFlush();
+    splashPending = false;
+    if (headless) {
+        if (isDirty()) sendFrame(); // nothing to pace without a bus, the whole frame is captured at once
+        return 0;
+    }
+    if (!isDirty()) {
+        framePending = false; // nothing left for tick() to send
+        pendingAsync = false;
+        return 0;
+    }
+    uint32_t start = micros();
+    uint8_t pages = height / 8;
+    uint16_t used = 0;
+    uint16_t windowCost = 6 + transport->overhead(6); // PAGEADDR + COLUMNADDR
+    uint32_t busBytes = transport->getBytes();
+#ifdef SSD1306_ENABLE_STATS
+    if (!stepping) countFrame(dirtyLo, dirtyHi); // the first step of a frame counts it
+#endif
+    stepping = true;
+
+    for (uint8_t page = 0; page < pages && used + windowCost < budget; page++) {
+        uint8_t lo = dirtyLo[page];
+        uint8_t hi = dirtyHi[page];
+        if (lo > hi) continue;
+
+        if (shadowValid) {
+            // skip the ends the panel already has, what's in between goes as one window
+            const unsigned char* cur = &ssd1306_buffer[page * width];
+            const unsigned char* old = &shadow_buffer[page * width];
+            while (lo <= hi && cur[lo] == old[lo]) lo++;
+            while (hi > lo && cur[hi] == old[hi]) hi--;
+            if (lo > hi || cur[lo] == old[lo]) {
+                dirtyLo[page] = width;
+                dirtyHi[page] = 0;
+                continue;
+            }
+        }
+
+        // as many columns as fit in what's left, with their control bytes
+        uint16_t room = budget - used - windowCost;
+        uint16_t cols = hi - lo + 1;
+        if (cols > room) cols = room;
+        while (cols > 0 && cols + transport->overhead(cols) > room) cols--;
+        if (cols == 0) break;
+        uint8_t end = lo + cols - 1;
+        sendWindow(ssd1306_buffer, page, page, lo, end);
+
+        used += windowCost + cols + transport->overhead(cols);
+        if (end == hi) {
+            dirtyLo[page] = width;
+            dirtyHi[page] = 0;
+        }
+        else {
+            dirtyLo[page] = end + 1;
+        }
+    }
+    // every byte marked by invalidate() went out at some point, the copy matches the panel now
+    bool done = !isDirty();
+    if (shadow_buffer != nullptr && done) shadowValid = true;
+
+    transport->wait();
+    if (done) {
+        stepping = false;
+        framePending = false; // the frame tick() was waiting for went out in steps
+        pendingAsync = false;
+        if (capture != nullptr) capture(ssd1306_buffer, width, height, captureCtx);
+    }
+    uint16_t wireBytes = transport->getBytes() - busBytes; // window commands and control bytes included
+    if (wireBytes) lastUpdateMicros = micros() - start;
+    return wireBytes;
+}
+
+/*!
+@brief tells if something was drawn (or marked) since the last update().
+*/
+bool puroPixel_SSD1306::isDirty() {
+    for (uint8_t page = 0; page < height / 8; page++) {
+        if (dirtyLo[page] <= dirtyHi[page]) return true;
+    }
+    return false;
+}
+
+/*!
+@brief keeps a copy of the last frame sent to the panel, so update() only sends the bytes that really changed. Costs one extra buffer (width * height / 8 bytes).
+@param enable
+    true to turn it on, false to turn it off and free the copy.
+@param gap
+    changed bytes separated by up to this many unchanged columns are sent as one window instead of two. Default is 8.
+@return true.
+*/
+bool puroPixel_SSD1306::enableShadow(bool enable, uint8_t gap) {
+    waitForFlush();
+    shadowGap = gap;
+    if (!enable) {
+        delete[] shadow_buffer;
+        shadow_buffer = nullptr;
+        shadowValid = false;
+        return true;
+    }
+    if (shadow_buffer == nullptr) {
+        shadow_buffer = new unsigned char[width * (height / 8)];
+        invalidate(); // we don't know what the panel has yet, the next update() sends everything and fills the copy
+    }
+    return true;
+}
+
+/*!
+@brief marks the whole buffer as changed, so the next update() sends everything.
+@note   use it after writing straight into getBuffer(), or when the panel lost its content.
+*/
+void puroPixel_SSD1306::invalidate() {
+    waitForFlush();
+    shadowValid = false;
+    markAllDirty();
+}
+
+void puroPixel_SSD1306::markAllDirty() {
+    for (uint8_t page = 0; page < SSD1306_MAX_PAGES; page++) {
+        dirtyLo[page] = 0;
+        dirtyHi[page] = width - 1;
+    }
+}
+
+void puroPixel_SSD1306::clearDirty() {
+    for (uint8_t page = 0; page < SSD1306_MAX_PAGES; page++) {
+        dirtyLo[page] = width;
+        dirtyHi[page] = 0;
+    }
+}
+
+/*!
+@brief marks an area as changed, the next update() will send it. The drawing functions already do this for you.
+@param x0
+    left column of the area.
+@param y0
+    top row of the area.
+@param x1
+    right column of the area (inclusive).
+@param y1
+    bottom row of the area (inclusive).
+*/
+void puroPixel_SSD1306::markDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= width) x1 = width - 1;
+    if (y1 >= height) y1 = height - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    for (uint8_t page = y0 / 8; page <= y1 / 8; page++) {
+        if (x0 < dirtyLo[page]) dirtyLo[page] = x0;
+        if (x1 > dirtyHi[page]) dirtyHi[page] = x1;
+    }
+}
+
+/*!
+@brief sends a list of raw SSD1306 commands (and their arguments) in a single transaction.
+@note   for things this library doesn't wrap yet. Example: const uint8_t cmds[] = { SSD1306_SETCONTRAST, 0x40 }; sendCommands(cmds, 2);
+@param cmds
+    the command bytes.
+@param len
+    how many bytes.
+*/
+void puroPixel_SSD1306::sendCommands(const uint8_t* cmds, uint8_t len) {
+    waitForFlush();
+    transmit_commands(cmds, len);
+}
+
+/*!
+@brief writes bytes straight into one page of the panel RAM, the buffer is not touched. For modes that own the panel, like puroPixel_Console.
+@note   the next update() doesn't know about it, call invalidate() when you go back to normal drawing.
+@param page
+    page of the panel RAM (0-7). The SSD1306 always has 8, even when the panel shows less of them.
+@param data
+    one byte per column, bit 0 on top.
+@param col0
+    first column.
+@param cols
+    how many columns, 0 (default) = up to the right edge.
+*/
+void puroPixel_SSD1306::sendPage(uint8_t page, const uint8_t* data, uint8_t col0, uint8_t cols) {
+    if (page >= SSD1306_MAX_PAGES || col0 >= width) return;
+    if (cols == 0 || cols > width - col0) cols = width - col0;
+    waitForFlush();
+    const unsigned char window[] = { SSD1306_PAGEADDR, page, page, SSD1306_COLUMNADDR, col0, (unsigned char)(col0 + cols - 1) };
+    transmit_commands(window, sizeof(window));
+    transmit_data(data, cols);
+}
+
+/*!
+@brief sets which row of the panel RAM is shown on the top of the screen, the rest follows and wraps around after row 63.
+    Moving it by 8 scrolls a whole text line with one command byte, see puroPixel_Console.
+@note   the buffer is not moved, while it is not 0 what you draw at y lands on screen row y - line (wrapped).
+@param line
+    0 to 63, 0 is the normal view.
+*/
+void puroPixel_SSD1306::setStartLine(uint8_t line) {
+    waitForFlush();
+    startLine = line & 0x3F;
+    transmit_command(SSD1306_SETSTARTLINE | startLine);
+}
+
+/*!
+@brief the row set with setStartLine(), 0 after begin().
+*/
+uint8_t puroPixel_SSD1306::getStartLine() {
+    return startLine;
+}
+
+/*!
+@brief how long the last update() took, in microseconds. Handy to budget full-screen refreshes.
+@return time spent in the last update().
+*/
+uint32_t puroPixel_SSD1306::getLastUpdateMicros() {
+    return lastUpdateMicros;
+}
+
+/*!
+@brief starts the background worker used by updateAsync(). It is a FreeRTOS task on ESP32 and a std::thread on host builds. Costs one extra buffer (width * height / 8 bytes).
+@note   after this, keep drawing as usual and call updateAsync() instead of update(). Functions that talk to the display (setContrast, scroll, update...) wait for the running flush first.
+@param priority
+    FreeRTOS priority of the worker task, ignored on host builds. Default is 1.
+@return false if this platform has no async backend or the worker could not be started, updateAsync() then works like update().
+*/
+bool puroPixel_SSD1306::beginAsync(uint8_t priority) {
+#if defined(SSD1306_ASYNC_FREERTOS) || defined(SSD1306_ASYNC_THREAD)
+    if (async != nullptr) return true;
+
+    uint16_t size = width * (height / 8);
+    front_buffer = new unsigned char[size];
+    ssd1306_copy(front_buffer, ssd1306_buffer, size);
+
+    async = new puroPixel_AsyncWorker();
+    async->busy = false;
+    async->stop = false;
+#if defined(SSD1306_ASYNC_FREERTOS)
+    async->start = xSemaphoreCreateBinary();
+    async->done = xSemaphoreCreateBinary();
+    if (async->start == nullptr || async->done == nullptr
+        || xTaskCreate(asyncWorker, "ssd1306", SSD1306_ASYNC_STACK, this, priority, &async->task) != pdPASS) {
+        if (async->start != nullptr) vSemaphoreDelete(async->start);
+        if (async->done != nullptr) vSemaphoreDelete(async->done);
+        delete async;
+        async = nullptr;
+        delete[] front_buffer;
+        front_buffer = nullptr;
+        return false;
+    }
+#else
+    (void)priority;
+    async->thread = std::thread(asyncWorker, this);
+#endif
+    return true;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
+/*!
+@brief waits for the running flush and stops the background worker. Called by the destructor too.
+*/
+void puroPixel_SSD1306::endAsync() {
+    if (async == nullptr) return;
+    waitForFlush();
+
+#if defined(SSD1306_ASYNC_FREERTOS)
+    xSemaphoreTake(async->done, 0); // drop a "done" nobody waited for
+    async->stop = true;
+    xSemaphoreGive(async->start);
+    xSemaphoreTake(async->done, portMAX_DELAY);
+    vSemaphoreDelete(async->start);
+    vSemaphoreDelete(async->done);
+#elif defined(SSD1306_ASYNC_THREAD)
+    {
+        std::lock_guard<std::mutex> guard(async->lock);
+        async->stop = true;
+    }
+    async->signal.notify_all();
+    async->thread.join();
+#endif
+
+    delete async;
+    async = nullptr;
+    delete[] front_buffer;
+    front_buffer = nullptr;
+}
+
+/*!
+@brief like update() but returns right away, the frame is sent in the background. You can draw the next frame while it goes out.
+@note   needs beginAsync(). The changed areas are copied to a second buffer first, so the panel always gets whole frames, never half of one and half of the next. If the previous frame is still being sent, this waits for it.
+@return true if the frame was handed to the worker, false if it was sent synchronously (no beginAsync()).
+*/
+bool puroPixel_SSD1306::updateAsync() {
+    if (async == nullptr || headless) {
+        update();
+        return false;
+    }
+    if (framePeriod != 0) {
+        update();
+        pendingAsync = true;
+        return true;
+    }
+    sendFrameAsync();
+    return true;
+}
+
+void puroPixel_SSD1306::sendFrameAsync() {
+    waitForFlush();
+    framePending = false;
+    pendingAsync = false;
+    splashPending = false;
+#ifdef SSD1306_ENABLE_STATS
+    if (!stepping) countFrame(dirtyLo, dirtyHi);
+#endif
+    stepping = false;
+    if (capture != nullptr) capture(ssd1306_buffer, width, height, captureCtx);
+
+    bool changed = false;
+    for (uint8_t page = 0; page < height / 8; page++) {
+        frontLo[page] = dirtyLo[page];
+        frontHi[page] = dirtyHi[page];
+        if (dirtyLo[page] > dirtyHi[page]) continue;
+
+        // the rest of the front buffer already matches, it was copied by an earlier frame
+        uint16_t index = page * width + dirtyLo[page];
+        memcpy(&front_buffer[index], &ssd1306_buffer[index], dirtyHi[page] - dirtyLo[page] + 1);
+        changed = true;
+    }
+    clearDirty();
+    if (!changed) return;
+
+#if defined(SSD1306_ASYNC_FREERTOS)
+    async->busy = true;
+    xSemaphoreGive(async->start);
+#elif defined(SSD1306_ASYNC_THREAD)
+    {
+        std::lock_guard<std::mutex> guard(async->lock);
+        async->busy = true;
+    }
+    async->signal.notify_all();
+#endif
+}
+
+/*!
+@brief caps how often frames go to the panel. update() (and updateAsync()) only mark the frame as waiting, and tick() sends it
+    at most once per period, so modules that each call update() after drawing cost one frame per period instead of one each.
+@note   call tick() from your loop(), as often as you can. updateNow() is for what can't wait.
+@param ms
+    frame period in milliseconds, 33 is about 30 frames/s. 0 (default) turns it off, a waiting frame is sent right away.
+*/
+void puroPixel_SSD1306::setFramePeriod(uint16_t ms) {
+    framePeriod = (uint32_t)ms * 1000;
+    lastFrame = micros() - framePeriod; // the first frame doesn't wait
+    if (framePeriod == 0 && framePending) {
+        if (pendingAsync && async != nullptr) sendFrameAsync();
+        else sendFrame();
+    }
+}
+
+/*!
+@brief sends the waiting frame once a frame period went by since the last one. Does nothing without setFramePeriod().
+@return true if a frame went out.
+*/
+bool puroPixel_SSD1306::tick() {
+    if (!framePending) return false;
+    uint32_t now = micros();
+    if ((uint32_t)(now - lastFrame) < framePeriod) return false;
+
+    // whole periods the frame sat there after its slot came
+    uint32_t due = lastFrame + framePeriod;
+    uint32_t late = (int32_t)(pendingSince - due) > 0 ? now - pendingSince : now - due;
+    pacing.dropped += late / framePeriod;
+    pacing.frames++;
+    lastFrame = now;
+    if (pendingAsync && async != nullptr) sendFrameAsync();
+    else sendFrame();
+    return true;
+}
+
+/*!
+@brief sends the frame right away, even with setFramePeriod(). For urgent content, like an alarm. A frame waiting for tick() goes out with it,
+    and it takes the slot of the period: the next tick() waits a full period again.
+*/
+void puroPixel_SSD1306::updateNow() {
+    if (framePeriod != 0) {
+        pacing.immediate++;
+        lastFrame = micros();
+    }
+    sendFrame();
+}
+
+/*!
+@brief true while update() was called but tick() didn't send the frame yet.
+*/
+bool puroPixel_SSD1306::isFramePending() {
+    return framePending;
+}
+
+/*!
+@brief counts of what the frame period did: update() calls, frames sent, requests merged into a waiting frame, missed periods and updateNow() calls.
+@param reset
+    sets them back to 0 after reading.
+*/
+framePacing puroPixel_SSD1306::getFramePacing(bool reset) {
+    framePacing result = pacing;
+    if (reset) pacing = {};
+    return result;
+}
+
+/*!
+@brief tells if a frame from updateAsync() is still being sent.
+*/
+bool puroPixel_SSD1306::isBusy() {
+    if (async == nullptr) return false;
+#if defined(SSD1306_ASYNC_FREERTOS)
+    return async->busy;
+#elif defined(SSD1306_ASYNC_THREAD)
+    std::lock_guard<std::mutex> guard(async->lock);
+    return async->busy;
+#else
+    return false;
+#endif
+}
+
+/*!
+@brief blocks until the frame from updateAsync() is on the panel. Returns right away if nothing is being sent.
+*/
+void puroPixel_SSD1306::waitForFlush() {
+    if (async == nullptr) return;
+#if defined(SSD1306_ASYNC_FREERTOS)
+    while (async->busy) {
+        xSemaphoreTake(async->done, portMAX_DELAY);
+    }
+#elif defined(SSD1306_ASYNC_THREAD)
+    std::unique_lock<std::mutex> guard(async->lock);
+    async->signal.wait(guard, [this] { return !async->busy; });
+#endif
+}
+
+void puroPixel_SSD1306::asyncWorker(void* self) {
+#if defined(SSD1306_ASYNC_FREERTOS) || defined(SSD1306_ASYNC_THREAD)
+    puroPixel_SSD1306* display = (puroPixel_SSD1306*)self;
+    puroPixel_AsyncWorker* worker = display->async;
+#endif
+
+#if defined(SSD1306_ASYNC_FREERTOS)
+    for (;;) {
+        xSemaphoreTake(worker->start, portMAX_DELAY);
+        if (worker->stop) break;
+
+        uint32_t start = micros();
+        display->flush(display->front_buffer, display->frontLo, display->frontHi);
+        display->lastUpdateMicros = micros() - start;
+        SSD1306_STAT(countLatency(display->stats.updateLatency, display->lastUpdateMicros));
+
+        worker->busy = false;
+        xSemaphoreGive(worker->done);
+    }
+    xSemaphoreGive(worker->done);
+    vTaskDelete(nullptr);
+#elif defined(SSD1306_ASYNC_THREAD)
+    std::unique_lock<std::mutex> guard(worker->lock);
+    for (;;) {
+        worker->signal.wait(guard, [worker] { return worker->busy || worker->stop; });
+        if (!worker->busy) break; // stopping and nothing left to send
+
+        guard.unlock();
+        uint32_t start = micros();
+        display->flush(display->front_buffer, display->frontLo, display->frontHi);
+        display->lastUpdateMicros = micros() - start;
+        SSD1306_STAT(countLatency(display->stats.updateLatency, display->lastUpdateMicros));
+        guard.lock();
+
+        worker->busy = false;
+        worker->signal.notify_all();
+    }
+#else
+    (void)self;
+#endif
 }
 
 void puroPixel_SSD1306::debugBuffer() {
-    for (int i = 0; i < 1024; i++) {
+    for (int i = 0; i < width * (height / 8); i++) {
         Serial.print(ssd1306_buffer[i], HEX);
         Serial.print(" ");
         if ((i + 1) % 16 == 0) {
@@ -81,60 +783,195 @@ void puroPixel_SSD1306::debugBuffer() {
     }
 }
 
+/*!
+@brief what the driver did since the last reset: pixels, primitive calls, bytes and transactions sent, dirty coverage and latency histograms.
+@note   all 0 unless the library is built with -DSSD1306_ENABLE_STATS (a global build flag, a #define in the sketch doesn't reach ssd1306.cpp). Waits for an updateAsync() frame still being sent, so its bytes are in.
+@param reset
+    true to start counting again right after reading, for numbers per frame (or per report).
+*/
+displayStats puroPixel_SSD1306::getStats(bool reset) {
+    waitForFlush();
+    displayStats copy = stats;
+    if (reset) resetStats();
+    return copy;
+}
+
+/*!
+@brief sets every counter and histogram back to 0.
+*/
+void puroPixel_SSD1306::resetStats() {
+    waitForFlush();
+    memset(&stats, 0, sizeof(stats));
+}
+
+// a primitive was called. The first one after a frame starts the render time
+void puroPixel_SSD1306::countCall(StatPrimitive kind) {
+    stats.calls[kind]++;
+    if (!rendering) {
+        rendering = true;
+        renderStart = micros();
+    }
+}
+
+// a frame goes out with these dirty windows: count the frame, its coverage and the render time that led to it
+void puroPixel_SSD1306::countFrame(const uint8_t* lo, const uint8_t* hi) {
+    stats.frames++;
+    for (uint8_t page = 0; page < height / 8; page++) {
+        if (lo[page] <= hi[page]) stats.dirtyBytes += hi[page] - lo[page] + 1;
+    }
+    if (rendering) {
+        countLatency(stats.renderLatency, micros() - renderStart);
+        rendering = false;
+    }
+}
+
+void puroPixel_SSD1306::countLatency(uint16_t* histogram, uint32_t us) {
+    uint8_t bucket = 0;
+    while (bucket < SSD1306_STATS_BUCKETS - 1 && us >= (256UL << bucket)) bucket++;
+    if (histogram[bucket] < 0xFFFF) histogram[bucket]++;
+}
+
+/*!
+@brief changes how the display talks to the panel (see transport.h), for example to 4-wire SPI. Call begin() after it.
+@param t
+    the new transport, it has to live as long as the display. nullptr goes back to the I2C one from the TwoWire constructor, on a display built with a transport it keeps the current one.
+*/
+void puroPixel_SSD1306::setTransport(puroPixel_Transport* t) {
+    if (t == nullptr) {
+        if (!i2cTransport.hasWire()) return;
+        t = &i2cTransport;
+    }
+    waitForFlush();
+    transport = t;
+}
+
+puroPixel_Transport* puroPixel_SSD1306::getTransport() {
+    return transport;
+}
+
+/*!
+@brief hands every frame to your function when update() runs, for recording, streaming or comparing frames (see examples/host/capture.h).
+@note   the buffer is only valid during the call, copy what you need. updateAsync() captures too, flushStep() once the last piece of a frame is sent.
+@param capture
+    called with the frame buffer (SSD1306 page order, width * height / 8 bytes). nullptr stops capturing.
+@param ctx
+    passed back to capture.
+@param headless
+    true: nothing goes to the bus at all (commands included) and begin() skips the splash, so UI code runs at full speed without a panel.
+    Going back to false resends the whole buffer on the next update() (call begin() again if it ran headless).
+*/
+void puroPixel_SSD1306::setFrameCapture(frameCaptureCallback cb, void* ctx, bool noBus) {
+    waitForFlush();
+    capture = cb;
+    captureCtx = ctx;
+    // headless update() cleared the dirty areas without sending them, the panel is behind the buffer now
+    if (headless && !noBus) invalidate();
+    headless = noBus;
+}
+
+/*!
+@brief true after setFrameCapture(..., true).
+*/
+bool puroPixel_SSD1306::isHeadless() {
+    return headless;
+}
+
 /*!
 @brief begins the class display. Loads all the required commands and in the end running an clear and a update.
 @note   remember to aways put this function after the wire begin function, or else expect errors.
+@param fastStart
+    false (default): shows the splash and waits for it (setSplashTime, 3 s by default) before returning.
+    true: shows the splash and returns right away. Your first update() replaces it, or service() clears it when the time is up.
 */
-bool puroPixel_SSD1306::begin() {
+bool puroPixel_SSD1306::begin(bool fastStart) {
     //Serial.println("Error [checkI2CDevice(...)]: Display SSD1306 not started. Did you forget Wire.begin()?");
-    transmit_command(SSD1306_DISPLAYOFF);
-    transmit_command(SSD1306_SETDISPLAYCLOCKDIV);
-    transmit_command(0x80);
-    transmit_command(SSD1306_SETMULTIPLEX);
-    transmit_command(0x3F); // Multiplex ratio (pode precisar de ajustes dependendo da tela)
-    transmit_command(SSD1306_SETDISPLAYOFFSET);
-    transmit_command(0x0);
-    transmit_command(SSD1306_SETSTARTLINE);
-    transmit_command(SSD1306_CHARGEPUMP);
-    transmit_command(0x14); // Para telas OLED de 128x64, pode ser necessário
-    transmit_command(SSD1306_MEMORYMODE);
-    transmit_command(0x00); // Horizontal addressing mode
-    transmit_command(SSD1306_SEGREMAP | 0x1); // Inverter de mapeamento de segmentos socorro
-    transmit_command(SSD1306_COMSCANDEC);
-    transmit_command(SSD1306_SETCOMPINS);
-    transmit_command(0x12); // Se o display for 128x64
-    transmit_command(SSD1306_SETCONTRAST);
-    transmit_command(0xCF); // Contraste máximo
-    transmit_command(SSD1306_SETPRECHARGE);
-    transmit_command(0xF1);
-    transmit_command(SSD1306_SETVCOMDETECT);
-    transmit_command(0x40); // VCOMH deselected voltage
-    transmit_command(SSD1306_DISABLE_SCROLL);
-    transmit_command(SSD1306_DISPLAYON);
+    waitForFlush();
+    uint32_t start = micros();
+    if (!headless) transport->begin();
+    if (initSequence) {
+        transmit_commands(initSequence, initLength);
+    }
+    else {
+        const unsigned char init[] = SSD1306_INIT_SEQUENCE(width, height);
+        transmit_commands(init, sizeof(init));
+    }
+    invalidate(); // fresh (or re-initialised) panel, nothing we sent before is there anymore
+    startLine = 0;
+    boot.init = micros() - start;
+    boot.splash = 0;
+    boot.clear = 0;
+    splashPending = false;
 
-    if (!noSplash) { // why no splash? bruh come on
+    if (!noSplash && !headless) { // why no splash? bruh come on
+        start = micros();
         clear();
-        drawBitmap(0, 0, epd_bitmap_splash_puro_pixel, 128, 64, 1);
-        update();
-        delay(3000);
+        drawPageBitmap(0, 0, epd_pages_splash_puro_pixel, 128, 64, BLIT_OPAQUE);
+        sendFrame();
+        boot.splash = micros() - start;
+
+        if (fastStart) {
+            // the splash stays on the panel, but the buffer is already empty for your first frame
+            clear();
+            splashPending = true;
+            splashStart = millis();
+            return true;
+        }
+        delay(splashTime);
     }
 
+    start = micros();
     clear();
-    update();
+    sendFrame();
+    boot.clear = micros() - start;
 
     return true;
 }
 
+/*!
+@brief call it from your loop() after begin(true). Clears the splash once its time is up, if no frame of yours replaced it already.
+@return true while the splash is still on the panel.
+*/
+bool puroPixel_SSD1306::service() {
+    if (!splashPending) return false;
+    if ((uint32_t)(millis() - splashStart) < splashTime) return true;
+
+    uint32_t start = micros();
+    sendFrame(); // the buffer was cleared by begin(), whatever you drew since then goes out too
+    boot.clear = micros() - start;
+    return false;
+}
+
+/*!
+@brief how long the splash stays on the panel.
+@param ms
+    milliseconds, default is 3000.
+*/
+void puroPixel_SSD1306::setSplashTime(uint16_t ms) {
+    splashTime = ms;
+}
+
+/*!
+@brief where the last begin() spent its time: init commands, splash and the first clear/update. In microseconds.
+*/
+bootTiming puroPixel_SSD1306::getBootTiming() {
+    return boot;
+}
+
 /*!
 @brief gets the current pixel (from the buffer)
 @param x
     X vector of the pixel, if width is 128, the middle would be 62.
 @param y
     Y vector of the pixel, if height is 64, the middle would be 32.
-@return bool
+@return true when the pixel is on, false when it is off or outside of the screen.
 */
 bool puroPixel_SSD1306::getPixel(int16_t x, int16_t y) {
-    return ssd1306_buffer[x + (y / 8) * width];
+    x += clip.originX;
+    y += clip.originY;
+    if ((x < 0) || (x >= width) || (y < 0) || (y >= height)) {
+        return false;
+    }
+    return (ssd1306_buffer[x + (y >> 3) * width] >> (y & 7)) & 1;
 }
 
 /*!
@@ -146,17 +983,145 @@ bool puroPixel_SSD1306::getPixel(int16_t x, int16_t y) {
 @param color
     defines the pixel state, 1 = on, 0 = off.
 */
-void puroPixel_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
-    if ((x < 0) || (x >= width) || (y < 0) || (y >= height)) {
-        return;
-    }
+void puroPixel_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    SSD1306_STAT(countCall(STAT_PIXEL));
+    x += clip.originX;
+    y += clip.originY;
+    if ((x < clip.x0) || (x > clip.x1) || (y < clip.y0) || (y > clip.y1)) {
+        return;
+    }
+
+    SSD1306_STAT(stats.pixels++);
+    uint8_t page = y >> 3;
+    if (color == 1) {
+        ssd1306_buffer[x + page * width] |= (1 << (y & 7));
+    }
+    else {
+        ssd1306_buffer[x + page * width] &= ~(1 << (y & 7));
+    }
+    if (x < dirtyLo[page]) dirtyLo[page] = x;
+    if (x > dirtyHi[page]) dirtyHi[page] = x;
+}
+
+// same as drawPixel but leaves the dirty tracking to the caller, the primitives mark their whole area once.
+// checked = false skips the clip test, only for primitives that made sure with clipContains() their box is inside.
+inline void puroPixel_SSD1306::writePixel(int16_t x, int16_t y, uint16_t color, bool checked) {
+    x += clip.originX;
+    y += clip.originY;
+    if (checked && ((x < clip.x0) || (x > clip.x1) || (y < clip.y0) || (y > clip.y1))) {
+        return;
+    }
+
+    SSD1306_STAT(stats.pixels++);
+    uint16_t index = x + (y >> 3) * width;
+    if (color == 1) {
+        ssd1306_buffer[index] |= (1 << (y & 7));
+    }
+    else {
+        ssd1306_buffer[index] &= ~(1 << (y & 7));
+    }
+}
+
+// true when [x0, x1] x [y0, y1] (drawing coordinates) is all inside the clip, so nothing in it needs a check
+bool puroPixel_SSD1306::clipContains(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    return x0 + clip.originX >= clip.x0 && x1 + clip.originX <= clip.x1 &&
+           y0 + clip.originY >= clip.y0 && y1 + clip.originY <= clip.y1;
+}
+
+// markDirty() for the primitives: their area is in drawing coordinates and only the clipped part changed
+void puroPixel_SSD1306::markDrawn(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    x0 += clip.originX;
+    y0 += clip.originY;
+    x1 += clip.originX;
+    y1 += clip.originY;
+    if (x0 < clip.x0) x0 = clip.x0;
+    if (y0 < clip.y0) y0 = clip.y0;
+    if (x1 > clip.x1) x1 = clip.x1;
+    if (y1 > clip.y1) y1 = clip.y1;
+    markDirty(x0, y0, x1, y1);
+}
+
+/*!
+@brief limits drawing to a rectangle, for example a widget area. Everything drawn until popClip() outside of it is cut,
+    and with moveOrigin the top left of the rectangle becomes (0, 0), so a widget draws the same wherever it is placed.
+@note   clips nest: the new rectangle is cut to the current one and given in the current coordinates. getPixel() uses the origin too.
+    clear(), fillScreen(), invert() and the direct buffer functions (markDirty, sendPage...) still work on the whole screen.
+@param x
+    left of the rectangle.
+@param y
+    top of the rectangle.
+@param w
+    width of the rectangle.
+@param h
+    height of the rectangle.
+@param moveOrigin
+    true (default) to move (0, 0) to x, y. false keeps the current origin.
+@return false if there are already SSD1306_CLIP_DEPTH clips, nothing changes then.
+*/
+bool puroPixel_SSD1306::pushClip(int16_t x, int16_t y, int16_t w, int16_t h, bool moveOrigin) {
+    if (clipDepth >= SSD1306_CLIP_DEPTH) return false;
+    clipStack[clipDepth++] = clip;
+
+    int16_t x0 = x + clip.originX;
+    int16_t y0 = y + clip.originY;
+    int16_t x1 = x0 + w - 1;
+    int16_t y1 = y0 + h - 1;
+    if (moveOrigin) {
+        clip.originX = x0;
+        clip.originY = y0;
+    }
+    if (x0 > clip.x0) clip.x0 = x0;
+    if (y0 > clip.y0) clip.y0 = y0;
+    if (x1 < clip.x1) clip.x1 = x1;
+    if (y1 < clip.y1) clip.y1 = y1;
+    return true;
+}
+
+/*!
+@brief goes back to the clip (and origin) from before the last pushClip().
+*/
+void puroPixel_SSD1306::popClip() {
+    if (clipDepth == 0) return;
+    clip = clipStack[--clipDepth];
+}
+
+/*!
+@brief drops every clip, drawing covers the whole screen from (0, 0) again.
+*/
+void puroPixel_SSD1306::resetClip() {
+    clip.x0 = 0;
+    clip.y0 = 0;
+    clip.x1 = width - 1;
+    clip.y1 = height - 1;
+    clip.originX = 0;
+    clip.originY = 0;
+    clipDepth = 0;
+}
 
-    uint16_t index = x + (y / 8) * width;
-    if (color == 1) {
-        ssd1306_buffer[index] |= (1 << (y & 7));
+// ORs (color 1) or clears (color 0) the set bits of a column word into column x, bit 0 landing on row y
+void puroPixel_SSD1306::blitColumn(int16_t x, int16_t y, uint32_t bits, uint16_t color) {
+    x += clip.originX;
+    y += clip.originY;
+    if (x < clip.x0 || x > clip.x1 || bits == 0) return;
+    if (y > clip.y1) return;
+    if (clip.y1 - y < 31) bits &= (1UL << (clip.y1 - y + 1)) - 1; // rows under the clip
+    if (y < clip.y0) {
+        if (y <= clip.y0 - 32) return;
+        bits >>= clip.y0 - y;
+        y = clip.y0;
     }
-    else {
-        ssd1306_buffer[index] &= ~(1 << (y & 7));
+
+    SSD1306_STAT(stats.pixels += __builtin_popcountl(bits));
+    uint64_t column = (uint64_t)bits << (y & 7);
+    uint8_t pages = height / 8;
+    unsigned char* dst = &ssd1306_buffer[(y >> 3) * width + x];
+    for (uint8_t page = y >> 3; column != 0 && page < pages; page++, dst += width, column >>= 8) {
+        if (color == 1) {
+            *dst |= (uint8_t)column;
+        }
+        else {
+            *dst &= ~(uint8_t)column;
+        }
     }
 }
 
@@ -166,10 +1131,50 @@ void puroPixel_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
     defines the pixel state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::fillScreen(uint16_t color) {
-    for (int y = 0; y < 64; y++) {
-        for (int x = 0; x < 128; x++) {
-            drawPixel(x, y, color);
+    SSD1306_STAT(countCall(STAT_SCREEN));
+    SSD1306_STAT(stats.pixels += width * height);
+    ssd1306_fill(ssd1306_buffer, color == 1 ? 0xFF : 0x00, width * (height / 8));
+    markAllDirty();
+    generation++;
+}
+
+// fills every pixel of [x0, x1] x [y0, y1] (inclusive). Clipped once, then worked page by page: whole bytes
+// for pages fully inside the area, one OR/AND mask for the partial top and bottom pages.
+void puroPixel_SSD1306::fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    x0 += clip.originX;
+    y0 += clip.originY;
+    x1 += clip.originX;
+    y1 += clip.originY;
+    if (x0 < clip.x0) x0 = clip.x0;
+    if (y0 < clip.y0) y0 = clip.y0;
+    if (x1 > clip.x1) x1 = clip.x1;
+    if (y1 > clip.y1) y1 = clip.y1;
+    if (x0 > x1 || y0 > y1) return;
+    SSD1306_STAT(stats.pixels += (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+
+    uint8_t page0 = y0 / 8;
+    uint8_t page1 = y1 / 8;
+    uint8_t topMask = 0xFF << (y0 & 7);
+    uint8_t bottomMask = 0xFF >> (7 - (y1 & 7));
+    uint8_t cols = x1 - x0 + 1;
+
+    for (uint8_t page = page0; page <= page1; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page0) mask &= topMask;
+        if (page == page1) mask &= bottomMask;
+
+        unsigned char* row = &ssd1306_buffer[page * width + x0];
+        if (mask == 0xFF) {
+            ssd1306_fill(row, color == 1 ? 0xFF : 0x00, cols);
         }
+        else if (color == 1) {
+            for (uint8_t i = 0; i < cols; i++) row[i] |= mask;
+        }
+        else {
+            for (uint8_t i = 0; i < cols; i++) row[i] &= ~mask;
+        }
+        if (x0 < dirtyLo[page]) dirtyLo[page] = x0;
+        if (x1 > dirtyHi[page]) dirtyHi[page] = x1;
     }
 }
 
@@ -185,9 +1190,8 @@ void puroPixel_SSD1306::fillScreen(uint16_t color) {
     defines the pixel state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::drawVerLine(int16_t x, int16_t y, int16_t h, int16_t color) {
-    for (int cH = 0; cH < h; cH++) {
-        drawPixel(x + cH, y, color);
-    }
+    SSD1306_STAT(countCall(STAT_LINE));
+    fillArea(x, y, x + h - 1, y, color);
 }
 
 /*!
@@ -202,9 +1206,8 @@ void puroPixel_SSD1306::drawVerLine(int16_t x, int16_t y, int16_t h, int16_t col
     defines the pixel state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::drawHorLine(int16_t x, int16_t y, int16_t w, int16_t color) {
-    for (int cW = 0; cW < w; cW++) {
-        drawPixel(x, y + cW, color);
-    }
+    SSD1306_STAT(countCall(STAT_LINE));
+    fillArea(x, y, x, y + w - 1, color);
 }
 
 /*!
@@ -221,10 +1224,12 @@ void puroPixel_SSD1306::drawHorLine(int16_t x, int16_t y, int16_t w, int16_t col
     defines the pixel state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::drawRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t color) {
-    drawVerLine(x, y, h, color); // right
-    drawHorLine(x + h, y, w, color); // down
-    drawVerLine(x, y + w, h, color); // right (left but starts from right)
-    drawHorLine(x, y, w, color); // down (up but starts from down)
+    SSD1306_STAT(countCall(STAT_RECT));
+    // the drawVerLine/drawHorLine runs, so a rectangle isn't counted as four lines too
+    fillArea(x, y, x + h - 1, y, color); // right
+    fillArea(x + h, y, x + h, y + w - 1, color); // down
+    fillArea(x, y + w, x + h - 1, y + w, color); // right (left but starts from right)
+    fillArea(x, y, x, y + w - 1, color); // down (up but starts from down)
 }
 
 /*!
@@ -241,16 +1246,17 @@ void puroPixel_SSD1306::drawRect(int16_t x, int16_t y, int16_t h, int16_t w, int
     defines the pixel state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::drawFillRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t color) {
-    drawVerLine(x, y, h, color); // right
-    drawHorLine(x + h, y, w, color); // down
-    drawVerLine(x, y + w, h, color); // right (left but starts from right)
-    drawHorLine(x, y, w, color); // down (up but starts from down)
-
-    for (int cH = 0; cH < h; cH++) {
-        for (int cW = 0; cW < w; cW++) {
-            drawPixel(x + cH, y + cW, color);
-        }
+    if (h <= 0 || w <= 0) {
+        drawRect(x, y, h, w, color); // nothing to fill, only the outline lines that still have a length
+        return;
     }
+    SSD1306_STAT(countCall(STAT_RECT));
+
+    // same pixels as drawRect + the inside: the inside already covers the top and left lines,
+    // the right and bottom lines sit one pixel outside of it
+    fillArea(x, y, x + h - 1, y + w - 1, color);
+    fillArea(x + h, y, x + h, y + w - 1, color); // right
+    fillArea(x, y + w, x + h - 1, y + w, color); // bottom
 }
 
 /*stringPos puroPixel_SSD1306::drawString(int16_t x, int16_t y, const char* str, uint16_t color) {
@@ -317,11 +1323,14 @@ void puroPixel_SSD1306::drawFillRect(int16_t x, int16_t y, int16_t h, int16_t w,
 @param textWrap
     defines if text breaks line if not fits. true or false (default is true)
 @note   the string is not centered, you have to do it manually. The function will return the offset of the string, so you can use it to center it.
+    Scales 2-4 keep the expanded glyphs in a small cache of this display (SSD1306_GLYPH_CACHE_SIZE), so different displays can draw text from
+    different tasks. Like every drawing function, one display is drawn from one task at a time.
 */
 stringPos puroPixel_SSD1306::drawString(int16_t x, int16_t y, const char* str, uint8_t scale, uint16_t color, bool textBg, bool textWrap) {
+    SSD1306_STAT(countCall(STAT_STRING));
     int xOffset = 0;
     int yOffset = 0;
-    int screenWidth = 128;
+    int screenWidth = clip.x1 - clip.originX + 1; // wraps at the right of the clip
     int charWidth = 6 * scale;
     int charHeight = 8 * scale;
 
@@ -336,7 +1345,7 @@ stringPos puroPixel_SSD1306::drawString(int16_t x, int16_t y, const char* str, u
         }
 
         // Ignora caracteres inválidos
-        if (character < 0x20 || character > 0x7F) continue;
+        if (character < 0x20 || (uint8_t)character > 0x7F) continue;
 
         // Verifica quebra automática de linha
         if (textWrap && (xOffset + charWidth > screenWidth)) {
@@ -346,43 +1355,154 @@ stringPos puroPixel_SSD1306::drawString(int16_t x, int16_t y, const char* str, u
 
         const char* charF = ASCII[character - 0x20];
 
-        // Desenha fundo com borda, se ativado
+        int16_t gx = x + xOffset;
+        int16_t gy = y + yOffset;
+
+        // Desenha fundo com borda, se ativado (one scaled pixel of border around the 6x8 cell)
         if (textBg) {
-            for (int cx = -1; cx <= 5; cx++) {
-                for (int j = -1; j <= 7; j++) {
-                    for (int dx = 0; dx < scale; dx++) {
-                        for (int dy = 0; dy < scale; dy++) {
-                            int16_t px = x + xOffset + (cx * scale) + dx;
-                            int16_t py = y + yOffset + (j * scale) + dy;
-                            drawPixel(px, py, !color);
-                        }
-                    }
+            fillArea(gx - scale, gy - scale, gx + charWidth - 1, gy + charHeight - 1, !color);
+        }
+
+        // Desenha o caractere. Font columns are already vertical bytes like the SSD1306 pages,
+        // so each (scaled) column is one shifted OR/AND over at most a few pages.
+        if (scale == 1) {
+            for (int cx = 0; cx < 5; cx++) {
+                blitColumn(gx + cx, gy, charF[cx] & 0x7F, color);
+            }
+        }
+        else if (scale <= 4) {
+            const uint32_t* cols = scaledGlyph(character, scale);
+            for (int cx = 0; cx < 5; cx++) {
+                for (int dx = 0; dx < scale; dx++) {
+                    blitColumn(gx + (cx * scale) + dx, gy, cols[cx], color);
                 }
             }
         }
-
-        // Desenha o caractere
-        for (int cx = 0; cx < 5; cx++) {
-            for (int j = 0; j < 7; j++) {
-                uint8_t pixel = (charF[cx] >> j) & 1;
-                if (pixel) {
-                    for (int dx = 0; dx < scale; dx++) {
-                        for (int dy = 0; dy < scale; dy++) {
-                            int16_t px = x + xOffset + (cx * scale) + dx;
-                            int16_t py = y + yOffset + (j * scale) + dy;
-                            drawPixel(px, py, color);
-                        }
+        else {
+            // too tall for a column word, one block per font pixel
+            for (int cx = 0; cx < 5; cx++) {
+                for (int j = 0; j < 7; j++) {
+                    if ((charF[cx] >> j) & 1) {
+                        fillArea(gx + (cx * scale), gy + (j * scale), gx + (cx * scale) + scale - 1, gy + (j * scale) + scale - 1, color);
                     }
                 }
             }
         }
 
+        if (textBg) {
+            markDrawn(x + xOffset - scale, y + yOffset - scale, x + xOffset + charWidth - 1, y + yOffset + charHeight - 1);
+        }
+        else {
+            markDrawn(x + xOffset, y + yOffset, x + xOffset + 5 * scale - 1, y + yOffset + 7 * scale - 1);
+        }
+
         xOffset += charWidth;
     }
 
     return { xOffset, yOffset + 7 * scale };
 }
 
+/*!
+@brief tells how big a string would be with drawString(), without drawing it. Same wrapping rules, so you can center before drawing.
+    Example: stringSize s = measureString("Hi", 2); drawString((128 - s.w) / 2, (64 - s.h) / 2, "Hi", 2);
+@param str
+    your string.
+@param scale
+    the scale of the font, like in drawString().
+@param textWrap
+    same as in drawString(), the text breaks at the display width (or the right of the clip).
+@return w x h in pixels of the lit area: no spacing after the last character, no textBg border.
+*/
+stringSize puroPixel_SSD1306::measureString(const char* str, uint8_t scale, bool textWrap) {
+    int xOffset = 0;
+    int yOffset = 0;
+    int widest = 0;
+    int charWidth = 6 * scale;
+    int charHeight = 8 * scale;
+
+    for (int i = 0; str[i] != '\0'; i++) {
+        char character = str[i];
+        if (character == '\n') {
+            xOffset = 0;
+            yOffset += charHeight;
+            continue;
+        }
+        if (character < 0x20 || (uint8_t)character > 0x7F) continue;
+        if (textWrap && (xOffset + charWidth > clip.x1 - clip.originX + 1)) {
+            xOffset = 0;
+            yOffset += charHeight;
+        }
+        xOffset += charWidth;
+        if (xOffset > widest) widest = xOffset;
+    }
+
+    if (widest == 0) return { 0, 0 };
+    return { widest - scale, yOffset + 7 * scale };
+}
+
+/*!
+@brief drawString() for labels that rarely change. It skips everything (no drawing, nothing dirty) when the text, position, scale and colors
+    are the same as the last call with this run and the buffer wasn't cleared since. When something changed, the old box is cleared and the new text drawn.
+@note   for UIs that keep the buffer between frames instead of clear() + redraw all. The old box is cleared to !color, so keep other drawings out of it.
+@param run
+    the label state, one per label. Start it zeroed: textRun label = {};
+@param x
+    X vector of the string.
+@param y
+    Y vector of the string.
+@param str
+    your string.
+@param scale
+    the scale of the font.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+@param textBg
+    text should have background?
+@param textWrap
+    defines if text breaks line if not fits.
+@return true if it drew, false when it was skipped.
+*/
+bool puroPixel_SSD1306::drawStringCached(textRun& run, int16_t x, int16_t y, const char* str, uint8_t scale, uint16_t color, bool textBg, bool textWrap) {
+    // FNV-1a over the text and the parameters
+    uint32_t hash = 2166136261UL;
+    for (const char* c = str; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    const int16_t params[] = { x, y, scale, (int16_t)color, textBg, textWrap };
+    for (uint8_t i = 0; i < 6; i++) {
+        hash = (hash ^ (uint8_t)params[i]) * 16777619UL;
+        hash = (hash ^ (uint8_t)(params[i] >> 8)) * 16777619UL;
+    }
+
+    bool sameFrame = run.generation == generation;
+    if (sameFrame && run.hash == hash) return false;
+    if (sameFrame && run.x0 <= run.x1) {
+        fillArea(run.x0, run.y0, run.x1, run.y1, color == 1 ? 0 : 1); // what the old text left behind
+    }
+
+    drawString(x, y, str, scale, color, textBg, textWrap);
+
+    stringSize size = measureString(str, scale, textWrap);
+    if (size.w == 0) {
+        run.x0 = 1;
+        run.x1 = 0; // nothing drawn, nothing to clear next time
+    }
+    else if (textBg) {
+        // the background is a scale wide border around every 6x8 cell
+        run.x0 = x - scale;
+        run.y0 = y - scale;
+        run.x1 = x + size.w + scale - 1;
+        run.y1 = y + size.h + scale - 1;
+    }
+    else {
+        run.x0 = x;
+        run.y0 = y;
+        run.x1 = x + size.w - 1;
+        run.y1 = y + size.h - 1;
+    }
+    run.hash = hash;
+    run.generation = generation;
+    return true;
+}
+
 /*!
 @brief draws an "image" from an bitmap. Kinda complex to use, but not that hard to understand.
 @param x
@@ -399,9 +1519,12 @@ stringPos puroPixel_SSD1306::drawString(int16_t x, int16_t y, const char* str, u
     defines the pixels state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+    SSD1306_STAT(countCall(STAT_BITMAP));
+    markDrawn(x, y, x + w - 1, y + h - 1);
 
     int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
     uint8_t b = 0;
+    bool checked = !clipContains(x, y, x + w - 1, y + h - 1);
 
     for (int16_t j = 0; j < h; j++, y++) {
         for (int16_t i = 0; i < w; i++) {
@@ -410,66 +1533,495 @@ void puroPixel_SSD1306::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
             else
                 b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
             if (b & 0x80)
-                drawPixel(x + i, y, color);
+                writePixel(x + i, y, color, checked);
+        }
+    }
+}
+
+/*!
+@brief draws an image stored in the SSD1306 page order: for each band of 8 rows, one byte per column with the top row in bit 0 (same as the display memory).
+@note   much faster than drawBitmap, the bytes are copied with at most one shift per column. Convert your images with examples/host/pbm2c.cpp.
+@param x
+    X vector of the image (left).
+@param y
+    Y vector of the image (top). Any value works, multiples of 8 are the fastest.
+@param bitmap
+    your bitmap, (h + 7) / 8 bands of w bytes.
+@param w
+    your bitmap width.
+@param h
+    your bitmap height.
+@param mode
+    BLIT_TRANSPARENT (default), BLIT_OPAQUE or BLIT_XOR.
+@param color
+    defines the pixels state, 1 = on, 0 = off (for BLIT_XOR it is ignored).
+*/
+void puroPixel_SSD1306::drawPageBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, BlitMode mode, uint16_t color) {
+    SSD1306_STAT(countCall(STAT_BITMAP));
+    if (w <= 0 || h <= 0) return;
+    int16_t sx = x + clip.originX; // screen position
+    int16_t sy = y + clip.originY;
+
+    // clip the columns once
+    int16_t col0 = sx < clip.x0 ? clip.x0 - sx : 0;
+    int16_t col1 = (sx + w - 1 > clip.x1) ? clip.x1 - sx : w - 1;
+    if (col0 > col1) return;
+
+    int16_t srcPages = (h + 7) / 8;
+    uint8_t shift = sy & 7;
+    int16_t firstPage = (sy - shift) / 8; // floor(sy / 8), also for negative y
+    int16_t clipPage0 = clip.y0 >> 3;
+    int16_t clipPage1 = clip.y1 >> 3;
+    uint8_t cols = col1 - col0 + 1;
+
+    for (int16_t sp = 0; sp < srcPages; sp++) {
+        int16_t page = firstPage + sp;
+        if (page + 1 < clipPage0) continue;
+        if (page > clipPage1) break;
+
+        // rows of this page and the next one the clip lets through, same layout as the shifted bits
+        uint16_t clipRows = 0xFFFF;
+        int16_t above = clip.y0 - page * 8;
+        int16_t below = page * 8 + 15 - clip.y1;
+        if (above > 0) clipRows <<= above;
+        if (below > 0) clipRows &= 0xFFFF >> below;
+
+        const uint8_t* src = &bitmap[sp * w + col0];
+        unsigned char* top = (page >= clipPage0) ? &ssd1306_buffer[page * width + sx + col0] : nullptr;
+        unsigned char* bottom = (shift != 0 && page + 1 <= clipPage1) ? &ssd1306_buffer[(page + 1) * width + sx + col0] : nullptr;
+        uint8_t rows = (sp == srcPages - 1 && (h & 7)) ? (h & 7) : 8;
+        uint16_t valid = ((uint16_t)((1 << rows) - 1) << shift) & clipRows;
+        if (top == nullptr) valid &= 0xFF00;
+        if (bottom == nullptr) valid &= 0x00FF;
+        SSD1306_STAT(stats.pixels += (uint32_t)cols * __builtin_popcount(valid));
+
+        if (mode == BLIT_OPAQUE && valid == 0xFF && color == 1 && top != nullptr) {
+            memcpy_P(top, src, cols); // byte aligned band, straight copy
+            continue;
+        }
+
+        for (uint8_t i = 0; i < cols; i++) {
+            uint8_t b = pgm_read_byte(&src[i]);
+            if (mode == BLIT_OPAQUE && color != 1) b = ~b;
+            uint16_t bits = ((uint16_t)b << shift) & valid;
+
+            if (mode == BLIT_XOR) {
+                if (top != nullptr) top[i] ^= (uint8_t)bits;
+                if (bottom != nullptr) bottom[i] ^= (uint8_t)(bits >> 8);
+            }
+            else if (mode == BLIT_OPAQUE) {
+                if (top != nullptr) top[i] = (top[i] & ~(uint8_t)valid) | (uint8_t)bits;
+                if (bottom != nullptr) bottom[i] = (bottom[i] & ~(uint8_t)(valid >> 8)) | (uint8_t)(bits >> 8);
+            }
+            else if (color == 1) {
+                if (top != nullptr) top[i] |= (uint8_t)bits;
+                if (bottom != nullptr) bottom[i] |= (uint8_t)(bits >> 8);
+            }
+            else {
+                if (top != nullptr) top[i] &= ~(uint8_t)bits;
+                if (bottom != nullptr) bottom[i] &= ~(uint8_t)(bits >> 8);
+            }
         }
     }
+    markDrawn(x, y, x + w - 1, y + h - 1);
 }
 
 /*!
-@brief draws an simple circle.
+@brief draws an simple circle (midpoint algorithm, integers only).
 @param x
-    X vector of the circle. You also have to expect an offeset dependind on the circle size.
+    X vector of the circle center.
 @param y
-    Y vector of the image. Same as X, you have to expect an offeset dependind on the circle size.
+    Y vector of the circle center.
 @param r
     the circle radius.
 @param a
-    agle/steps, do SMALL increments on this number if you wanna an smooth circle. Recommended is 0.1
+    not used anymore, the circle is always closed and one pixel thick. Kept so old code still compiles.
 @param color
     defines the pixels state, 1 = on, 0 = off.
 */
 void puroPixel_SSD1306::drawCircle(int16_t x, int16_t y, int16_t r, int16_t a, uint16_t color) {
-    for (float angle = 0; angle < 2 * PI; angle += a) {
-        int fx = x + r * cos(angle);
-        int fy = y + r * sin(angle);
-        drawPixel(fx, fy, color);
+    SSD1306_STAT(countCall(STAT_CIRCLE));
+    (void)a;
+    if (r < 0) return;
+    bool checked = !clipContains(x - r, y - r, x + r, y + r);
+
+    int16_t f = 1 - r;
+    int16_t ddx = 1;
+    int16_t ddy = -2 * r;
+    int16_t px = 0;
+    int16_t py = r;
+
+    writePixel(x, y + r, color, checked);
+    writePixel(x, y - r, color, checked);
+    writePixel(x + r, y, color, checked);
+    writePixel(x - r, y, color, checked);
+    while (px < py) {
+        if (f >= 0) {
+            py--;
+            ddy += 2;
+            f += ddy;
+        }
+        px++;
+        ddx += 2;
+        f += ddx;
+
+        writePixel(x + px, y + py, color, checked);
+        writePixel(x - px, y + py, color, checked);
+        writePixel(x + px, y - py, color, checked);
+        writePixel(x - px, y - py, color, checked);
+        writePixel(x + py, y + px, color, checked);
+        writePixel(x - py, y + px, color, checked);
+        writePixel(x + py, y - px, color, checked);
+        writePixel(x - py, y - px, color, checked);
     }
+    markDrawn(x - r, y - r, x + r, y + r);
 }
 
+/*!
+@brief draws an filled circle. Every pixel with dx*dx + dy*dy <= r*r is drawn.
+@param x
+    X vector of the circle center.
+@param y
+    Y vector of the circle center.
+@param r
+    the circle radius.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+*/
 void puroPixel_SSD1306::drawFillCircle(int16_t x, int16_t y, int16_t r, uint16_t color) {
-    for (int16_t dy = -r; dy <= r; dy++) {
-        int16_t dx_limit = sqrt(r * r - dy * dy); // Calcula a largura da linha usando a equação do círculo
-        for (int16_t dx = -dx_limit; dx <= dx_limit; dx++) {
-            drawPixel(x + dx, y + dy, color); // Desenha os pixels horizontalmente
+    SSD1306_STAT(countCall(STAT_CIRCLE));
+    if (r < 0) return;
+
+    // one vertical span per column (whole page bytes in the middle), height = floor(sqrt(r*r - dx*dx))
+    int32_t rr = (int32_t)r * r;
+    int16_t dy = r;
+    for (int16_t dx = 0; dx <= r; dx++) {
+        while ((int32_t)dx * dx + (int32_t)dy * dy > rr) dy--;
+        fillArea(x + dx, y - dy, x + dx, y + dy, color);
+        if (dx != 0) fillArea(x - dx, y - dy, x - dx, y + dy, color);
+    }
+}
+
+/*!
+@brief draws an ellipse outline (midpoint algorithm, integers only).
+@param x
+    X vector of the center.
+@param y
+    Y vector of the center.
+@param rx
+    horizontal radius.
+@param ry
+    vertical radius.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+*/
+void puroPixel_SSD1306::drawEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color) {
+    ellipse(x, y, rx, ry, color, false);
+}
+
+/*!
+@brief draws an filled ellipse.
+@param x
+    X vector of the center.
+@param y
+    Y vector of the center.
+@param rx
+    horizontal radius.
+@param ry
+    vertical radius.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+*/
+void puroPixel_SSD1306::drawFillEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color) {
+    ellipse(x, y, rx, ry, color, true);
+}
+
+// both halves of the midpoint ellipse: first where the slope is under 1 (stepping x), then the steep part
+// (stepping y). Filled, every point becomes the vertical span between its mirrored pair.
+void puroPixel_SSD1306::ellipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color, bool fill) {
+    SSD1306_STAT(countCall(STAT_ELLIPSE));
+    if (rx < 0 || ry < 0) return;
+    if (rx == 0 || ry == 0) {
+        fillArea(x - rx, y - ry, x + rx, y + ry, color); // flat, it's a line
+        return;
+    }
+
+    bool checked = !clipContains(x - rx, y - ry, x + rx, y + ry);
+    int64_t a2 = (int64_t)rx * rx;
+    int64_t b2 = (int64_t)ry * ry;
+    int64_t sigma;
+    int16_t px, py;
+
+    for (px = 0, py = ry, sigma = 2 * b2 + a2 * (1 - 2 * ry); b2 * px <= a2 * py; px++) {
+        ellipsePoints(x, y, px, py, color, fill, checked);
+        if (sigma >= 0) {
+            sigma += 4 * a2 * (1 - py);
+            py--;
+        }
+        sigma += b2 * (4 * px + 6);
+    }
+    int16_t spanPy = -1;
+    for (px = rx, py = 0, sigma = 2 * a2 + b2 * (1 - 2 * rx); a2 * py <= b2 * px; py++) {
+        // in the steep part a column gets several points, a fill only needs its tallest one
+        if (!fill || sigma >= 0) ellipsePoints(x, y, px, py, color, fill, checked);
+        spanPy = fill && sigma < 0 ? py : -1;
+        if (sigma >= 0) {
+            sigma += 4 * b2 * (1 - px);
+            px--;
+        }
+        sigma += a2 * (4 * py + 6);
+    }
+    if (spanPy >= 0) ellipsePoints(x, y, px, spanPy, color, fill, checked);
+    if (!fill) markDrawn(x - rx, y - ry, x + rx, y + ry);
+}
+
+void puroPixel_SSD1306::ellipsePoints(int16_t x, int16_t y, int16_t px, int16_t py, uint16_t color, bool fill, bool checked) {
+    if (fill) {
+        fillArea(x + px, y - py, x + px, y + py, color);
+        fillArea(x - px, y - py, x - px, y + py, color);
+        return;
+    }
+    writePixel(x + px, y + py, color, checked);
+    writePixel(x - px, y + py, color, checked);
+    writePixel(x + px, y - py, color, checked);
+    writePixel(x - px, y - py, color, checked);
+}
+
+// sin(0..90 degrees) * 1024, the arc ends are the only place that needs an angle
+static const int16_t sinTable[91] PROGMEM = {
+    0, 18, 36, 54, 71, 89, 107, 125, 143, 160, 178, 195, 213,
+    230, 248, 265, 282, 299, 316, 333, 350, 367, 384, 400, 416, 433,
+    449, 465, 481, 496, 512, 527, 543, 558, 573, 587, 602, 616, 630,
+    644, 658, 672, 685, 698, 711, 724, 737, 749, 761, 773, 784, 796,
+    807, 818, 828, 839, 849, 859, 868, 878, 887, 896, 904, 912, 920,
+    928, 935, 943, 949, 956, 962, 968, 974, 979, 984, 989, 994, 998,
+    1002, 1005, 1008, 1011, 1014, 1016, 1018, 1020, 1022, 1023, 1023, 1024, 1024
+};
+
+static int16_t sin1024(int16_t degrees) {
+    degrees %= 360;
+    if (degrees < 0) degrees += 360;
+    if (degrees <= 90) return pgm_read_word(&sinTable[degrees]);
+    if (degrees <= 180) return pgm_read_word(&sinTable[180 - degrees]);
+    if (degrees <= 270) return -(int16_t)pgm_read_word(&sinTable[degrees - 180]);
+    return -(int16_t)pgm_read_word(&sinTable[360 - degrees]);
+}
+
+/*!
+@brief draws a piece of a circle outline, good for gauges. 0 degrees points right and the angle grows clockwise (towards the bottom of the screen).
+@param x
+    X vector of the center.
+@param y
+    Y vector of the center.
+@param r
+    the radius.
+@param start
+    angle where the arc starts, in degrees.
+@param end
+    angle where the arc ends, in degrees. The arc goes clockwise from start to end, 360 degrees or more is a full circle, end == start a single pixel.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+*/
+void puroPixel_SSD1306::drawArc(int16_t x, int16_t y, int16_t r, int16_t start, int16_t end, uint16_t color) {
+    if (r < 0) return;
+    int16_t sweep = end - start;
+    if (sweep >= 360 || sweep <= -360) {
+        drawCircle(x, y, r, 0, color); // counted there
+        return;
+    }
+    SSD1306_STAT(countCall(STAT_CIRCLE));
+    if (sweep < 0) sweep += 360;
+
+    // the ends as vectors, a point is inside when it sits between them (cross products, no angles per point)
+    int32_t sx = sin1024(start + 90), sy = sin1024(start);
+    int32_t ex = sin1024(end + 90), ey = sin1024(end);
+    if (sweep == 0) {
+        // both cross products are 0 on the opposite ray too, so the point at start is drawn on its own
+        int16_t dx = (int16_t)((r * sx + (sx < 0 ? -512 : 512)) / 1024);
+        int16_t dy = (int16_t)((r * sy + (sy < 0 ? -512 : 512)) / 1024);
+        writePixel(x + dx, y + dy, color);
+        markDrawn(x + dx, y + dy, x + dx, y + dy);
+        return;
+    }
+    // a short arc also has to face the same way as its middle, so nothing lands on the rays opposite the ends
+    int32_t mx = sx + ex, my = sy + ey;
+    bool checked = !clipContains(x - r, y - r, x + r, y + r);
+
+    int16_t f = 1 - r;
+    int16_t ddx = 1;
+    int16_t ddy = -2 * r;
+    int16_t px = 0;
+    int16_t py = r;
+    for (;;) {
+        const int16_t points[8][2] = {
+            { px, py }, { (int16_t)-px, py }, { px, (int16_t)-py }, { (int16_t)-px, (int16_t)-py },
+            { py, px }, { (int16_t)-py, px }, { py, (int16_t)-px }, { (int16_t)-py, (int16_t)-px }
+        };
+        for (uint8_t i = 0; i < 8; i++) {
+            int32_t dx = points[i][0], dy = points[i][1];
+            bool afterStart = sx * dy - sy * dx >= 0;
+            bool beforeEnd = dx * ey - dy * ex >= 0;
+            bool inside = sweep <= 180 ? (afterStart && beforeEnd && (sweep >= 90 || mx * dx + my * dy >= 0)) : (afterStart || beforeEnd);
+            if (inside) writePixel(x + dx, y + dy, color, checked);
+        }
+
+        if (px >= py) break;
+        if (f >= 0) {
+            py--;
+            ddy += 2;
+            f += ddy;
+        }
+        px++;
+        ddx += 2;
+        f += ddx;
+    }
+    markDrawn(x - r, y - r, x + r, y + r);
+}
+
+/*!
+@brief draws an rectangle with round corners. Same axes as drawRect: h goes along X and w along Y, the box is h x w pixels.
+@param x
+    X vector of the top left corner.
+@param y
+    Y vector of the top left corner.
+@param h
+    size along X.
+@param w
+    size along Y.
+@param r
+    corner radius, limited to half of the smallest side.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+*/
+void puroPixel_SSD1306::drawRoundRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t r, uint16_t color) {
+    roundRect(x, y, h, w, r, color, false);
+}
+
+/*!
+@brief draws an filled rectangle with round corners. Same axes as drawRect: h goes along X and w along Y, the box is h x w pixels.
+@param x
+    X vector of the top left corner.
+@param y
+    Y vector of the top left corner.
+@param h
+    size along X.
+@param w
+    size along Y.
+@param r
+    corner radius, limited to half of the smallest side.
+@param color
+    defines the pixels state, 1 = on, 0 = off.
+*/
+void puroPixel_SSD1306::drawFillRoundRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t r, uint16_t color) {
+    roundRect(x, y, h, w, r, color, true);
+}
+
+void puroPixel_SSD1306::roundRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t r, uint16_t color, bool fill) {
+    SSD1306_STAT(countCall(STAT_RECT));
+    if (h <= 0 || w <= 0) return;
+    int16_t maxR = ((h < w ? h : w) - 1) / 2; // both arcs of a side have to fit in it
+    if (r > maxR) r = maxR;
+    if (r < 0) r = 0;
+
+    int16_t x1 = x + h - 1;
+    int16_t y1 = y + w - 1;
+    int16_t left = x + r, right = x1 - r;   // corner centers
+    int16_t top = y + r, bottom = y1 - r;
+
+    if (fill) {
+        fillArea(left, y, right, y1, color); // the straight middle, full height
+    }
+    else {
+        fillArea(left, y, right, y, color);   // top
+        fillArea(left, y1, right, y1, color); // bottom
+        fillArea(x, top, x, bottom, color);   // left
+        fillArea(x1, top, x1, bottom, color); // right
+    }
+    if (r == 0) return;
+
+    bool checked = !clipContains(x, y, x1, y1);
+    int16_t f = 1 - r;
+    int16_t ddx = 1;
+    int16_t ddy = -2 * r;
+    int16_t px = 0;
+    int16_t py = r;
+    while (px < py) {
+        if (f >= 0) {
+            py--;
+            ddy += 2;
+            f += ddy;
+        }
+        px++;
+        ddx += 2;
+        f += ddx;
+
+        if (fill) {
+            // the corners as vertical spans from the top arc to the bottom arc
+            fillArea(left - px, top - py, left - px, bottom + py, color);
+            fillArea(left - py, top - px, left - py, bottom + px, color);
+            fillArea(right + px, top - py, right + px, bottom + py, color);
+            fillArea(right + py, top - px, right + py, bottom + px, color);
+        }
+        else {
+            writePixel(left - px, top - py, color, checked);
+            writePixel(left - py, top - px, color, checked);
+            writePixel(right + px, top - py, color, checked);
+            writePixel(right + py, top - px, color, checked);
+            writePixel(left - px, bottom + py, color, checked);
+            writePixel(left - py, bottom + px, color, checked);
+            writePixel(right + px, bottom + py, color, checked);
+            writePixel(right + py, bottom + px, color, checked);
         }
     }
+    if (!fill) markDrawn(x, y, x1, y1);
 }
+
 /*!
 @brief this function invert the polarity. If 1 = 0, 0 = 1, white to black, black to white.
 @note   Needs update().
 */
 void puroPixel_SSD1306::invert() {
-    for (int i = 0; i < (128 * 64 / 8); i++) { // Percorre todo o buffer
-        ssd1306_buffer[i] = ~ssd1306_buffer[i]; // Inverte os bits do byte
-    }
+    SSD1306_STAT(countCall(STAT_SCREEN));
+    SSD1306_STAT(stats.pixels += width * height);
+    ssd1306_invert(ssd1306_buffer, width * (height / 8));
+    markAllDirty();
+    generation++;
 }
 
 /*!
 @brief gets the current buffer
+@note   if you write into it directly, call invalidate() so the next update() sends it.
 */
 unsigned char* puroPixel_SSD1306::getBuffer() {
     return ssd1306_buffer;
 }
 
+/*!
+@brief the width given to the constructor, in pixels.
+*/
+uint8_t puroPixel_SSD1306::getWidth() {
+    return width;
+}
+
+/*!
+@brief the height given to the constructor, in pixels.
+*/
+uint8_t puroPixel_SSD1306::getHeight() {
+    return height;
+}
+
 /*!
 @brief replace the buffer to the new one. Before you send make the math and check the buffer size. do: width * (height / 8) and then, you should have it.
 @note depending on your display size it MUST MATCH! 8 PAGES! DO THE MATH!
 
+@note the buffer stays yours, the display never frees it. With beginAsync() the background flush works on its own copy, so swapping is safe at any time.
 @param b the buffer to be sent. Req Size: [width * (height / 8)]
 */
 void puroPixel_SSD1306::setBuffer(unsigned char* newBuffer) {
     if (newBuffer == nullptr) return;
     ssd1306_buffer = newBuffer;
+    markAllDirty();
+    generation++;
 }
 
 /*!
@@ -485,55 +2037,112 @@ void puroPixel_SSD1306::setBuffer(unsigned char* newBuffer) {
     scroll speed. SPEED_256_FRAMES = slowest, SPEED_2_FRAMES = fastest i.g
 */
 void puroPixel_SSD1306::startScroll(ScrollDirection direction, uint8_t start, uint8_t end, ScrollSpeed speed) {
+    waitForFlush();
     stopScroll(); // Sempre parar qualquer scroll ativo
 
     if (direction == SCROLL_DIAG_LEFT || direction == SCROLL_DIAG_RIGHT) {
-        // 1. Configura área de scroll vertical antes de tudo
-        transmit_command(SSD1306_SET_VERTICAL_SCROLL_AREA);
-        transmit_command(0x00);    // Área fixa no topo
-        transmit_command(height);  // Área que vai rolar
+        const unsigned char cmds[] = {
+            SSD1306_SET_VERTICAL_SCROLL_AREA, 0x00, height, // nothing fixed on top, the whole height scrolls
+            (unsigned char)(direction == SCROLL_DIAG_LEFT ? SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL : SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL),
+            0x00,  // dummy
+            start, // start page
+            (unsigned char)speed,
+            end,   // end page
+            0x01,  // vertical offset (at least 1 to move)
+            SSD1306_ACTIVATE_SCROLL
+        };
+        transmit_commands(cmds, sizeof(cmds));
+    }
+    else {
+        const unsigned char cmds[] = {
+            (unsigned char)(direction == SCROLL_RIGHT ? SSD1306_RIGHT_HORIZONTAL_SCROLL : SSD1306_LEFT_HORIZONTAL_SCROLL),
+            0x00,  // dummy
+            start, // start page
+            (unsigned char)speed,
+            end,   // end page
+            0x00,  // dummy
+            0xFF,  // dummy
+            SSD1306_ACTIVATE_SCROLL
+        };
+        transmit_commands(cmds, sizeof(cmds));
+    }
+}
 
-        // 2. Escolhe tipo de scroll
-        if (direction == SCROLL_DIAG_LEFT) {
-            transmit_command(SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL);
-        }
-        else {
-            transmit_command(SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL);
-        }
 
-        // 3. Argumentos do scroll diagonal
-        transmit_command(0x00);  // Dummy
-        transmit_command(start); // Página inicial
-        transmit_command(speed); // Velocidade
-        transmit_command(end);   // Página final
-        transmit_command(0x01);  // Vertical offset (mínimo 1 pra se mover)
-        transmit_command(0xFF);  // Dummy
 
-        // 4. Ativa o scroll
-        transmit_command(SSD1306_ACTIVATE_SCROLL);
-    }
-    else {
-        // Scroll horizontal simples
-        if (direction == SCROLL_RIGHT) {
-            transmit_command(SSD1306_RIGHT_HORIZONTAL_SCROLL);
+/*!
+@brief moves a band of pages one column on the panel (content scroll, 0x2C/0x2D) and in the buffer, then sends only the column that comes in.
+    That's 1 byte per page on the bus instead of the whole band, made for tickers (see puroPixel_Ticker).
+@note   the panel needs about 2 frames (~20 ms with the default clock) between two steps, faster ones can be dropped by it.
+    Changes waiting for update() in the band move along with it.
+@param page0
+    first page of the band (0-7).
+@param page1
+    last page of the band.
+@param column
+    the new column, one byte per page (page0 first). nullptr brings in an empty column.
+@param left
+    true (default) moves left and the new column shows up on the right edge, false the other way around.
+*/
+void puroPixel_SSD1306::scrollContent(uint8_t page0, uint8_t page1, const uint8_t* column, bool left) {
+    uint8_t pages = height / 8;
+    if (page1 >= pages) page1 = pages - 1;
+    if (page0 > page1) return;
+    waitForFlush();
+
+    uint8_t edge = left ? width - 1 : 0;
+    unsigned char incoming[SSD1306_MAX_PAGES];
+    for (uint8_t page = page0; page <= page1; page++) {
+        unsigned char* row = &ssd1306_buffer[page * width];
+        unsigned char in = column ? column[page - page0] : 0x00;
+        if (left) memmove(row, row + 1, width - 1);
+        else memmove(row + 1, row, width - 1);
+        row[edge] = in;
+        incoming[page - page0] = in;
+        if (shadow_buffer != nullptr) {
+            // the panel RAM moved too, the copy has to follow it
+            unsigned char* copy = &shadow_buffer[page * width];
+            if (left) memmove(copy, copy + 1, width - 1);
+            else memmove(copy + 1, copy, width - 1);
+            copy[edge] = in;
+        }
+
+        // pending changes moved with the content, the one that fell off the edge is gone
+        if (dirtyLo[page] > dirtyHi[page]) continue;
+        if (left) {
+            if (dirtyHi[page] == 0) {
+                dirtyLo[page] = width;
+                continue;
+            }
+            if (dirtyLo[page] > 0) dirtyLo[page]--;
+            dirtyHi[page]--;
         }
         else {
-            transmit_command(SSD1306_LEFT_HORIZONTAL_SCROLL);
+            if (dirtyLo[page] == width - 1) {
+                dirtyLo[page] = width;
+                dirtyHi[page] = 0;
+                continue;
+            }
+            dirtyLo[page]++;
+            if (dirtyHi[page] < width - 1) dirtyHi[page]++;
         }
-
-        // Argumentos do scroll horizontal
-        transmit_command(0x00);  // Dummy
-        transmit_command(start); // Página inicial
-        transmit_command(speed); // Velocidade
-        transmit_command(end);   // Página final
-        transmit_command(0x00);  // Dummy
-        transmit_command(0xFF);  // Dummy
-
-        transmit_command(SSD1306_ACTIVATE_SCROLL);
     }
-}
-
 
+    // the step and the window for the new column go in one command transaction
+    const unsigned char cmds[] = {
+        (unsigned char)(left ? SSD1306_CONTENT_SCROLL_LEFT : SSD1306_CONTENT_SCROLL_RIGHT),
+        0x00,  // dummy
+        page0, // start page
+        0x01,  // dummy
+        page1, // end page
+        0x00,  // start column
+        (unsigned char)(width - 1), // end column
+        SSD1306_PAGEADDR, page0, page1,
+        SSD1306_COLUMNADDR, edge, edge
+    };
+    transmit_commands(cmds, sizeof(cmds));
+    transmit_data(incoming, page1 - page0 + 1); // a one column window goes down the pages
+}
 
 /*!
 @brief stops the scroll, usually when stops it not return to the middle. To fix that after the stop command, is executed automatically an update() but you can disable by setting the update param.
@@ -542,8 +2151,12 @@ void puroPixel_SSD1306::startScroll(ScrollDirection direction, uint8_t start, ui
     sets at the end an update() to return the display to the center.
 */
 void puroPixel_SSD1306::stopScroll(bool upd) {
+    waitForFlush();
     transmit_command(SSD1306_DISABLE_SCROLL);
-    if (upd) update();
+    if (upd) {
+        invalidate(); // the panel moved under us, resend everything
+        sendFrame();
+    }
 }
 
 /*!
@@ -553,6 +2166,7 @@ void puroPixel_SSD1306::stopScroll(bool upd) {
     min: 0, max: 255, recommended: 207 (also u can use hex 0xFF etc...)
 */
 void puroPixel_SSD1306::setContrast(uint16_t con) {
-    transmit_command(SSD1306_SETCONTRAST);
-    transmit_command(con);
+    waitForFlush();
+    const unsigned char cmds[] = { SSD1306_SETCONTRAST, (unsigned char)con };
+    transmit_commands(cmds, sizeof(cmds));
 }
\ No newline at end of file
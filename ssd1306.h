@@ -4,6 +4,7 @@
 #include "wire.h"
 #include "Arduino.h"
 #include "splash.h"
+#include "transport.h"
 #include "utility"
 
 // Based on the adafruit and sparkfun libraries
@@ -34,6 +35,96 @@
 #define SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL 0x29 ///< Init diag scroll
 #define SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL 0x2A  ///< Init diag scroll
 #define SSD1306_SET_VERTICAL_SCROLL_AREA 0xA3             ///< Set scroll range
+#define SSD1306_CONTENT_SCROLL_RIGHT 0x2C                 ///< Move the content one column right
+#define SSD1306_CONTENT_SCROLL_LEFT 0x2D                  ///< Move the content one column left
+
+#define SSD1306_MAX_PAGES 8 ///< 64 rows / 8, the biggest panel the controller can drive
+
+#define SSD1306_CONTROL_COMMAND 0x00 ///< Co = 0, D/C = 0: command stream
+#define SSD1306_CONTROL_DATA    0x40 ///< Co = 0, D/C = 1: data stream
+
+// Size of the TwoWire TX buffer, the control byte takes one slot of every transaction.
+#ifndef SSD1306_WIRE_MAX
+#if defined(I2C_BUFFER_LENGTH)
+#define SSD1306_WIRE_MAX I2C_BUFFER_LENGTH
+#elif defined(BUFFER_LENGTH)
+#define SSD1306_WIRE_MAX BUFFER_LENGTH
+#else
+#define SSD1306_WIRE_MAX 32
+#endif
+#endif
+
+// How deep pushClip() can nest. Fixed on purpose: it sizes a member of the display, a different value in the sketch
+// than in ssd1306.cpp would give them two layouts of the same class.
+#define SSD1306_CLIP_DEPTH 4
+
+// Opt-in counters (getStats()), build with -DSSD1306_ENABLE_STATS. Without it the counting isn't compiled and getStats()
+// stays at 0. The counters are in the class either way, so a sketch and ssd1306.cpp built with and without the flag
+// still agree on its layout, but only a global flag (build_flags, -D) turns counting on in the library itself.
+#ifdef SSD1306_ENABLE_STATS
+#define SSD1306_STAT(x) x
+#else
+#define SSD1306_STAT(x)
+#endif
+
+// Latency histogram buckets: bucket i counts durations under 256 << i microseconds (256 us, 512 us ... 65 ms),
+// the last one everything longer.
+#define SSD1306_STATS_BUCKETS 10
+
+// How many pre-scaled glyphs (scale 2 to 4) drawString keeps around per display, about 28 bytes each. The count is stored
+// in the display, so the sketch and ssd1306.cpp may disagree on it.
+#ifndef SSD1306_GLYPH_CACHE_SIZE
+#define SSD1306_GLYPH_CACHE_SIZE 16
+#endif
+
+// Geometry dependent init values. The multiplex ratio is the row count - 1, panels taller than 32 rows use
+// the alternative COM pin configuration (128x64, 64x48), the short ones the sequential one (128x32, 96x16).
+constexpr uint8_t ssd1306_multiplex(uint8_t h) { return h - 1; }
+constexpr uint8_t ssd1306_compins(uint8_t h) { return h > 32 ? 0x12 : 0x02; }
+
+// Whole bring-up sequence as one command stream, so begin() is a single I2C transaction.
+// With constant w/h (like in a template) it is a compile-time table.
+#define SSD1306_INIT_SEQUENCE(w, h) {                                   \
+    SSD1306_DISPLAYOFF,                                                 \
+    SSD1306_SETDISPLAYCLOCKDIV, 0x80,                                   \
+    SSD1306_SETMULTIPLEX, ssd1306_multiplex(h),                         \
+    SSD1306_SETDISPLAYOFFSET, 0x00,                                     \
+    SSD1306_SETSTARTLINE,                                               \
+    SSD1306_CHARGEPUMP, 0x14,              /* internal charge pump on */ \
+    SSD1306_MEMORYMODE, 0x00,              /* horizontal addressing */   \
+    SSD1306_SEGREMAP | 0x1,                                             \
+    SSD1306_COMSCANDEC,                                                 \
+    SSD1306_SETCOMPINS, ssd1306_compins(h),                             \
+    SSD1306_SETCONTRAST, 0xCF,                                          \
+    SSD1306_SETPRECHARGE, 0xF1,                                         \
+    SSD1306_SETVCOMDETECT, 0x40,                                        \
+    SSD1306_DISABLE_SCROLL,                                             \
+    SSD1306_DISPLAYON                                                   \
+}
+
+// Backend for updateAsync(): a FreeRTOS task on ESP32, a std::thread on host builds, plain update() elsewhere.
+#if !defined(SSD1306_ASYNC_NONE) && !defined(SSD1306_ASYNC_FREERTOS) && !defined(SSD1306_ASYNC_THREAD)
+#if defined(ESP32)
+#define SSD1306_ASYNC_FREERTOS
+#elif !defined(ARDUINO)
+#define SSD1306_ASYNC_THREAD
+#endif
+#endif
+
+// Stack of the FreeRTOS worker task behind updateAsync(), in bytes. The transport (Wire, SPI...) runs on it.
+#ifndef SSD1306_ASYNC_STACK
+#define SSD1306_ASYNC_STACK 4096
+#endif
+
+struct puroPixel_AsyncWorker;
+
+// A glyph at scale 2-4 expanded vertically into one column word per font column (7 * scale bits, LSB on top).
+struct glyphCacheEntry {
+    char character;
+    uint8_t scale; // 0 = empty slot
+    uint32_t used;
+    uint32_t cols[5];
+};
 
 enum ScrollDirection {
     SCROLL_LEFT,
@@ -48,6 +139,13 @@ enum PixelState {
     PIXEL_ON = 1,
 };
 
+// how drawPageBitmap combines the image with what is already in the buffer
+enum BlitMode {
+    BLIT_TRANSPARENT, // set bits are drawn with color, the rest is left alone (like drawBitmap)
+    BLIT_OPAQUE,      // the whole w x h area is replaced, set bits get color and clear bits the opposite
+    BLIT_XOR          // set bits flip the pixel under them
+};
+
 enum ScrollSpeed {
     SPEED_5_FRAMES = 0x00,
     SPEED_64_FRAMES = 0x01,
@@ -65,13 +163,94 @@ struct stringPos {
     int y;
 };
 
+// what measureString() returns: the box the text would cover, in pixels (0 x 0 for an empty string)
+struct stringSize {
+    int w;
+    int h;
+};
+
+// a label drawn with drawStringCached(), it remembers what it drew so an unchanged label costs nothing.
+// Start it zeroed: textRun label = {};
+struct textRun {
+    uint32_t hash;       // text, position, scale and colors of the last draw
+    uint16_t generation; // buffer generation it was drawn in, clear()/fillScreen()/invert()/setBuffer() start a new one
+    int16_t x0, y0, x1, y1; // box it covered, cleared before drawing a different text
+};
+
+// a saved clip rectangle (screen coordinates, inclusive) and drawing origin, see pushClip()
+struct clipState {
+    int16_t x0, y0, x1, y1;
+    int16_t originX, originY;
+};
+
+// primitive kinds counted in displayStats::calls
+enum StatPrimitive {
+    STAT_PIXEL,   // drawPixel
+    STAT_LINE,    // drawHorLine, drawVerLine
+    STAT_RECT,    // drawRect, drawFillRect, drawRoundRect, drawFillRoundRect
+    STAT_CIRCLE,  // drawCircle, drawFillCircle, drawArc
+    STAT_ELLIPSE, // drawEllipse, drawFillEllipse
+    STAT_STRING,  // drawString (and drawStringCached when it draws)
+    STAT_BITMAP,  // drawBitmap, drawPageBitmap
+    STAT_SCREEN,  // clear, fillScreen, invert
+    STAT_KINDS
+};
+
+// what getStats() returns, everything since the last reset. Compare dirtyBytes with dataBytes and frames * the
+// buffer size to see how much of the screen a frame touches and how much of that really goes out.
+struct displayStats {
+    uint32_t pixels;            // pixels written by the primitives (fills count their whole area, text its lit pixels)
+    uint32_t calls[STAT_KINDS]; // primitive calls, by StatPrimitive
+    uint32_t frames;            // frames sent by update() and updateAsync() (by tick() with setFramePeriod())
+    uint32_t dirtyBytes;        // buffer bytes inside the dirty windows at those calls
+    uint32_t dataBytes;         // GDDRAM bytes sent (after the enableShadow() diff)
+    uint32_t busBytes;          // everything sent: data, commands and control bytes
+    uint32_t transactions;      // I2C transactions
+    uint16_t updateLatency[SSD1306_STATS_BUCKETS]; // how long sending a frame took
+    uint16_t renderLatency[SSD1306_STATS_BUCKETS]; // from the first draw after a frame to the next update()
+};
+
+// gets every frame update() sends (or would send, headless), see setFrameCapture()
+typedef void (*frameCaptureCallback)(const unsigned char* buffer, uint8_t width, uint8_t height, void* ctx);
+
+// where begin() spent its time, in microseconds
+struct bootTiming {
+    uint32_t init;   // init command sequence
+    uint32_t splash; // drawing and sending the splash (0 with no splash)
+    uint32_t clear;  // the first clear() + update() (with fastStart only set when service() clears the splash)
+};
+
+// what setFramePeriod() did with your update() calls, see getFramePacing()
+struct framePacing {
+    uint32_t requests;  // update() and updateAsync() calls while paced
+    uint32_t frames;    // frames sent by tick()
+    uint32_t coalesced; // requests merged into a frame that was already waiting
+    uint32_t dropped;   // frame periods missed with a frame waiting (tick() called late, or a flush longer than the period)
+    uint32_t immediate; // updateNow() calls
+};
+
 class puroPixel_SSD1306 {
 public:
     puroPixel_SSD1306(uint8_t addr, uint8_t w, uint8_t h, TwoWire* i2c, bool ns = false);
-    bool begin();
+    puroPixel_SSD1306(puroPixel_Transport* transport, uint8_t w, uint8_t h, bool ns = false);
+    ~puroPixel_SSD1306();
+    // a copy would free the same buffers twice and talk through the other one's transport, pass a pointer or reference
+    puroPixel_SSD1306(const puroPixel_SSD1306&) = delete;
+    puroPixel_SSD1306& operator=(const puroPixel_SSD1306&) = delete;
+    bool begin(bool fastStart = false);
+    bool service();
+    void setSplashTime(uint16_t ms);
+    bootTiming getBootTiming();
     void update();
+    void updateNow();
+    void setFramePeriod(uint16_t ms);
+    bool tick();
+    bool isFramePending();
+    framePacing getFramePacing(bool reset = false);
     void clear();
     unsigned char* getBuffer();
+    uint8_t getWidth();
+    uint8_t getHeight();
     bool getPixel(int16_t x, int16_t y);
     void setBuffer(unsigned char* b);
     void setContrast(uint16_t i = 207);
@@ -83,22 +262,187 @@ public:
     void drawPixel(int16_t x, int16_t y, uint16_t color = 1);
     //stringPos drawString(int16_t x, int16_t y, const char* str, uint16_t color = 1);
     stringPos drawString(int16_t x, int16_t y, const char* str, uint8_t scale = 1, uint16_t color = 1, bool textBg = false, bool textWrap = true);
+    stringSize measureString(const char* str, uint8_t scale = 1, bool textWrap = true);
+    bool drawStringCached(textRun& run, int16_t x, int16_t y, const char* str, uint8_t scale = 1, uint16_t color = 1, bool textBg = false, bool textWrap = true);
     //stringPos drawBgString(int16_t x, int16_t y, const char* str, uint8_t scale = 1, uint16_t color = 1, uint16_t borderSize = 0);
     void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color = 1);
+    void drawPageBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, BlitMode mode = BLIT_TRANSPARENT, uint16_t color = 1);
     void drawCircle(int16_t x, int16_t y, int16_t r, int16_t a = 0.1, uint16_t color = 1);
     void drawFillCircle(int16_t x, int16_t y, int16_t r, uint16_t color = 1);
+    void drawEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color = 1);
+    void drawFillEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color = 1);
+    void drawArc(int16_t x, int16_t y, int16_t r, int16_t start, int16_t end, uint16_t color = 1);
+    void drawRoundRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t r, uint16_t color = 1);
+    void drawFillRoundRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t r, uint16_t color = 1);
     void stopScroll(bool update = true);
     void startScroll(ScrollDirection direction = SCROLL_LEFT, uint8_t start = 0, uint8_t end = 7, ScrollSpeed speed = SPEED_2_FRAMES);
+    void scrollContent(uint8_t page0, uint8_t page1, const uint8_t* column, bool left = true);
     void invert();
+    bool pushClip(int16_t x, int16_t y, int16_t w, int16_t h, bool moveOrigin = true);
+    void popClip();
+    void resetClip();
+    uint32_t getLastUpdateMicros();
+    void setTransport(puroPixel_Transport* transport);
+    puroPixel_Transport* getTransport();
+    void setFrameCapture(frameCaptureCallback capture, void* ctx = nullptr, bool headless = false);
+    bool isHeadless();
+    displayStats getStats(bool reset = false);
+    void resetStats();
+    void invalidate();
+    void markDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    bool isDirty();
+    uint16_t flushStep(uint16_t budget);
+    bool enableShadow(bool enable = true, uint8_t gap = 8);
+    bool beginAsync(uint8_t priority = 1);
+    void endAsync();
+    bool updateAsync();
+    bool isBusy();
+    void waitForFlush();
+    void sendCommands(const uint8_t* cmds, uint8_t len);
+    void sendPage(uint8_t page, const uint8_t* data, uint8_t col0 = 0, uint8_t cols = 0);
+    void setStartLine(uint8_t line);
+    uint8_t getStartLine();
+protected:
+    puroPixel_SSD1306(uint8_t addr, uint8_t w, uint8_t h, TwoWire* i2c, bool ns, unsigned char* buffer, glyphCacheEntry* glyphs, uint8_t glyphCount, const unsigned char* init, uint8_t initLen);
+    void markAllDirty();
+    unsigned char* ssd1306_buffer;
+    uint8_t dirtyLo[SSD1306_MAX_PAGES]; // first dirty column per page, width when the page is clean
+    uint8_t dirtyHi[SSD1306_MAX_PAGES]; // last dirty column per page
+    uint16_t generation = 1; // bumped when the whole buffer is replaced, textRun uses it
+    uint8_t clipDepth = 0;   // pushClip() calls not popped yet, 0 = whole screen and no offset
+    displayStats stats = {};
+    bool rendering = false;  // something was drawn since the last frame, renderStart is when
+    uint32_t renderStart = 0;
+    void countCall(StatPrimitive kind);
+    void countFrame(const uint8_t* lo, const uint8_t* hi);
+    static void countLatency(uint16_t* histogram, uint32_t us);
 private:
     uint8_t width, height;
-    uint8_t address;
-    TwoWire* wire;
-    unsigned char* ssd1306_buffer;
+    puroPixel_I2CTransport i2cTransport; // used by the TwoWire constructor
+    puroPixel_Transport* transport;
+    unsigned char* owned_buffer; // the one we allocated, setBuffer() never takes ownership of yours
+    const unsigned char* initSequence = nullptr; // compile-time init table of the static variant, built in begin() otherwise
+    uint8_t initLength = 0;
     bool noSplash = false;
+    bool splashPending = false; // fastStart splash still on the panel
+    uint16_t splashTime = 3000;
+    uint32_t splashStart = 0;
+    bootTiming boot = { 0, 0, 0 };
+    uint32_t lastUpdateMicros = 0;
+    uint32_t framePeriod = 0;  // microseconds, 0 = update() sends right away
+    uint32_t lastFrame = 0;    // micros() when tick() or updateNow() last sent
+    uint32_t pendingSince = 0; // micros() of the first update() folded into the waiting frame
+    bool framePending = false;
+    bool pendingAsync = false; // the waiting frame came from updateAsync(), tick() hands it to the worker
+    bool stepping = false;     // flushStep() sent part of a frame, the rest is still dirty
+    framePacing pacing = {};
+    unsigned char* shadow_buffer = nullptr; // last frame actually sent to the panel, only with enableShadow()
+    bool shadowValid = false;
+    frameCaptureCallback capture = nullptr;
+    void* captureCtx = nullptr;
+    bool headless = false; // nothing goes to the bus, update() only hands the frame to capture
+    uint8_t shadowGap = 8;
+    uint8_t startLine = 0; // GDDRAM row shown on top of the panel
+    puroPixel_AsyncWorker* async = nullptr;
+    unsigned char* front_buffer = nullptr; // snapshot the async worker is sending, the app keeps drawing in ssd1306_buffer
+    uint8_t frontLo[SSD1306_MAX_PAGES];
+    uint8_t frontHi[SSD1306_MAX_PAGES];
+    clipState clip;          // current clip, always inside the screen
+    clipState clipStack[SSD1306_CLIP_DEPTH];
+    glyphCacheEntry* glyphCache = nullptr;   // drawString's scaled glyphs, allocated on first use unless the template has them
+    glyphCacheEntry* owned_glyphs = nullptr;
+    uint8_t glyphCacheSize = 0;
+    uint32_t glyphClock = 0;
+    const uint32_t* scaledGlyph(char character, uint8_t scale);
+    bool clipContains(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void writePixel(int16_t x, int16_t y, uint16_t color, bool checked = true);
+    void markDrawn(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void blitColumn(int16_t x, int16_t y, uint32_t bits, uint16_t color);
+    void ellipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color, bool fill);
+    void ellipsePoints(int16_t x, int16_t y, int16_t px, int16_t py, uint16_t color, bool fill, bool checked);
+    void roundRect(int16_t x, int16_t y, int16_t h, int16_t w, int16_t r, uint16_t color, bool fill);
+    void clearDirty();
+    void sendFrame();
+    void sendFrameAsync();
+    void flush(const unsigned char* src, const uint8_t* lo, const uint8_t* hi);
+    void sendWindow(const unsigned char* src, uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1);
+    void sendPageDiff(const unsigned char* src, uint8_t page, uint8_t col0, uint8_t col1);
+    static void asyncWorker(void* self);
     void transmit_command(unsigned char c);
+    void transmit_commands(const unsigned char* cmds, uint8_t len);
+    void transmit_data(const unsigned char* data, uint16_t len);
     void debugBuffer();
-    bool checkI2CDevice(uint8_t address);
+    bool checkI2CDevice();
 };
 
-#endif
\ No newline at end of file
+/*!
+@brief same display, but the geometry is a template parameter: puroPixel_SSD1306_Static<128, 32> display(0x3C, &Wire);
+    The frame buffer and the drawString glyph cache live inside the object (no heap, put it in a global and it is in .bss), the init table is built at compile time
+    and clear/fillScreen/invert/drawPixel run with constant sizes, so the compiler can unroll them.
+@note   enableShadow() and beginAsync() still allocate their extra buffer when you call them.
+*/
+template <uint8_t W, uint8_t H>
+class puroPixel_SSD1306_Static : public puroPixel_SSD1306 {
+    static_assert(W > 0 && W <= 128, "the SSD1306 has 128 columns at most");
+    static_assert(H > 0 && H <= 64 && H % 8 == 0, "the height has to be a multiple of 8, up to 64 rows");
+public:
+    static constexpr uint8_t pages = H / 8;
+    static constexpr uint16_t bufferSize = W * pages;
+    static constexpr unsigned char initTable[] = SSD1306_INIT_SEQUENCE(W, H);
+
+    puroPixel_SSD1306_Static(uint8_t addr, TwoWire* i2c, bool ns = false)
+        : puroPixel_SSD1306(addr, W, H, i2c, ns, frame, glyphs, SSD1306_GLYPH_CACHE_SIZE, initTable, sizeof(initTable)) {}
+
+    puroPixel_SSD1306_Static(puroPixel_Transport* t, bool ns = false)
+        : puroPixel_SSD1306(0, W, H, nullptr, ns, frame, glyphs, SSD1306_GLYPH_CACHE_SIZE, initTable, sizeof(initTable)) {
+        setTransport(t);
+    }
+
+    // these work on ssd1306_buffer and not on frame, setBuffer() may have swapped it
+    void clear() {
+        SSD1306_STAT(countCall(STAT_SCREEN));
+        SSD1306_STAT(stats.pixels += W * H);
+        memset(ssd1306_buffer, 0x00, bufferSize);
+        markAllDirty();
+        generation++;
+    }
+
+    void fillScreen(uint16_t color = 1) {
+        SSD1306_STAT(countCall(STAT_SCREEN));
+        SSD1306_STAT(stats.pixels += W * H);
+        memset(ssd1306_buffer, color == 1 ? 0xFF : 0x00, bufferSize);
+        markAllDirty();
+        generation++;
+    }
+
+    void invert() {
+        SSD1306_STAT(countCall(STAT_SCREEN));
+        SSD1306_STAT(stats.pixels += W * H);
+        for (uint16_t i = 0; i < bufferSize; i++) ssd1306_buffer[i] = ~ssd1306_buffer[i];
+        markAllDirty();
+        generation++;
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color = 1) {
+        if (clipDepth) {
+            puroPixel_SSD1306::drawPixel(x, y, color); // offset and clip rectangle
+            return;
+        }
+        SSD1306_STAT(countCall(STAT_PIXEL));
+        if ((uint16_t)x >= W || (uint16_t)y >= H) return; // negative wraps to a big unsigned
+        SSD1306_STAT(stats.pixels++);
+        if (color == 1) ssd1306_buffer[x + (y / 8) * W] |= (1 << (y & 7));
+        else ssd1306_buffer[x + (y / 8) * W] &= ~(1 << (y & 7));
+        if (x < dirtyLo[y / 8]) dirtyLo[y / 8] = x;
+        if (x > dirtyHi[y / 8]) dirtyHi[y / 8] = x;
+    }
+private:
+    unsigned char frame[bufferSize];
+    glyphCacheEntry glyphs[SSD1306_GLYPH_CACHE_SIZE] = {};
+};
+
+template <uint8_t W, uint8_t H>
+constexpr unsigned char puroPixel_SSD1306_Static<W, H>::initTable[];
+
+#endif
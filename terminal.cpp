@@ -0,0 +1,197 @@
+#include "terminal.h"
+#include "font.h"
+#include <stdarg.h>
+
+#define TERMINAL_INVERSE 0x80
+#define TERMINAL_UNKNOWN 0x00 // never a valid cell, forces a redraw
+
+/*!
+@brief creates a terminal covering the whole display. It starts empty and doesn't draw until render().
+@param display
+    the display.
+*/
+puroPixel_Terminal::puroPixel_Terminal(puroPixel_SSD1306* d) {
+    display = d;
+    cols = d->getWidth() / 6;
+    rows = d->getHeight() / 8;
+    if (cols > SSD1306_TERMINAL_COLS) cols = SSD1306_TERMINAL_COLS;
+    if (rows > SSD1306_TERMINAL_ROWS) rows = SSD1306_TERMINAL_ROWS;
+    clear();
+    invalidate();
+}
+
+/*!
+@brief empties the grid and puts the cursor at the top left. The cells go blank on the next render().
+*/
+void puroPixel_Terminal::clear() {
+    memset(cells, ' ', sizeof(cells));
+    cursorX = 0;
+    cursorY = 0;
+}
+
+/*!
+@brief moves the cursor, the next write goes there.
+@param col
+    column, 0 to getCols() - 1.
+@param row
+    row, 0 to getRows() - 1.
+*/
+void puroPixel_Terminal::setCursor(uint8_t col, uint8_t row) {
+    cursorX = col < cols ? col : cols - 1;
+    cursorY = row < rows ? row : rows - 1;
+}
+
+uint8_t puroPixel_Terminal::getCursorX() {
+    return cursorX;
+}
+
+uint8_t puroPixel_Terminal::getCursorY() {
+    return cursorY;
+}
+
+/*!
+@brief text written from now on is dark on a lit cell (like drawString with textBg).
+*/
+void puroPixel_Terminal::setInverse(bool inv) {
+    inverse = inv;
+}
+
+/*!
+@brief writes one character at the cursor. '\n' goes to the next line, '\r' back to column 0, at the bottom everything scrolls up.
+*/
+void puroPixel_Terminal::write(char character) {
+    if (character == '\n') {
+        cursorX = 0;
+        if (++cursorY >= rows) scroll();
+        return;
+    }
+    if (character == '\r') {
+        cursorX = 0;
+        return;
+    }
+    if (character < 0x20 || character > 0x7E) return;
+
+    if (cursorX >= cols) {
+        cursorX = 0;
+        if (++cursorY >= rows) scroll();
+    }
+    cells[cursorY][cursorX++] = character | (inverse ? TERMINAL_INVERSE : 0);
+}
+
+/*!
+@brief writes a string at the cursor.
+*/
+void puroPixel_Terminal::print(const char* text) {
+    while (*text) write(*text++);
+}
+
+/*!
+@brief printf at the cursor, up to SSD1306_TERMINAL_PRINTF_SIZE characters.
+*/
+void puroPixel_Terminal::printf(const char* format, ...) {
+    char text[SSD1306_TERMINAL_PRINTF_SIZE + 1];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    print(text);
+}
+
+/*!
+@brief writes text at a fixed cell without moving the cursor, cut at the end of the row. Good for labels and values that update in place.
+*/
+void puroPixel_Terminal::putAt(uint8_t col, uint8_t row, const char* text) {
+    if (row >= rows) return;
+    for (; *text && col < cols; text++) {
+        if (*text < 0x20 || *text > 0x7E) continue;
+        cells[row][col++] = *text | (inverse ? TERMINAL_INVERSE : 0);
+    }
+}
+
+void puroPixel_Terminal::scroll() {
+    memmove(cells[0], cells[1], (rows - 1) * SSD1306_TERMINAL_COLS);
+    memset(cells[rows - 1], ' ', SSD1306_TERMINAL_COLS);
+    cursorY = rows - 1;
+}
+
+/*!
+@brief draws the cells that changed since the last render() into the buffer and marks their columns dirty. update() still sends them.
+@return how many cells were drawn.
+*/
+uint16_t puroPixel_Terminal::render() {
+    unsigned char* buffer = display->getBuffer();
+    uint8_t width = display->getWidth();
+    uint16_t drawn = 0;
+
+    for (uint8_t row = 0; row < rows; row++) {
+        windowLo[row] = cols;
+        windowHi[row] = 0;
+        for (uint8_t col = 0; col < cols; col++) {
+            char cell = cells[row][col];
+            if (cell == shown[row][col]) continue;
+            shown[row][col] = cell;
+
+            // a cell is exactly 6 bytes of its page, the font columns are already page bytes
+            const char* charF = ASCII[(cell & 0x7F) - 0x20];
+            uint8_t mask = (cell & TERMINAL_INVERSE) ? 0xFF : 0x00;
+            unsigned char* dst = &buffer[row * width + col * 6];
+            for (uint8_t cx = 0; cx < 5; cx++) dst[cx] = (charF[cx] & 0x7F) ^ mask;
+            dst[5] = mask;
+
+            if (col < windowLo[row]) windowLo[row] = col;
+            windowHi[row] = col;
+            drawn++;
+        }
+        if (windowLo[row] <= windowHi[row]) {
+            display->markDirty(windowLo[row] * 6, row * 8, windowHi[row] * 6 + 5, row * 8 + 7);
+        }
+    }
+    return drawn;
+}
+
+/*!
+@brief the column windows the last render() changed, one per page at most, for your own partial flush.
+@param out
+    where to put them.
+@param max
+    room in out.
+@return how many windows were written.
+*/
+uint8_t puroPixel_Terminal::getWindows(termWindow* out, uint8_t max) {
+    uint8_t count = 0;
+    for (uint8_t row = 0; row < rows && count < max; row++) {
+        if (windowLo[row] > windowHi[row]) continue;
+        out[count].page = row;
+        out[count].col0 = windowLo[row] * 6;
+        out[count].col1 = windowHi[row] * 6 + 5;
+        count++;
+    }
+    return count;
+}
+
+/*!
+@brief render() + the display update().
+*/
+void puroPixel_Terminal::update() {
+    render();
+    display->update();
+}
+
+/*!
+@brief forgets what is on screen, the next render() draws every cell. Call it after clearing or drawing over the terminal area.
+*/
+void puroPixel_Terminal::invalidate() {
+    memset(shown, TERMINAL_UNKNOWN, sizeof(shown));
+    for (uint8_t row = 0; row < SSD1306_TERMINAL_ROWS; row++) {
+        windowLo[row] = cols;
+        windowHi[row] = 0;
+    }
+}
+
+uint8_t puroPixel_Terminal::getCols() {
+    return cols;
+}
+
+uint8_t puroPixel_Terminal::getRows() {
+    return rows;
+}
@@ -0,0 +1,55 @@
+#ifndef SSD1306_TERMINAL_H__
+#define SSD1306_TERMINAL_H__
+
+#include "ssd1306.h"
+
+// Text grid on top of the 6x8 font: 21 x 8 cells on a 128x64 panel, one text row per page. Writes only change
+// the grid, render() rasterizes the cells that really changed (6 bytes each, straight into the buffer) and
+// marks just their columns dirty, so the cost follows the number of changed characters, not the screen size.
+
+#define SSD1306_TERMINAL_COLS (128 / 6)
+#define SSD1306_TERMINAL_ROWS SSD1306_MAX_PAGES
+
+#ifndef SSD1306_TERMINAL_PRINTF_SIZE
+#define SSD1306_TERMINAL_PRINTF_SIZE 64 // longest printf() output, the rest is cut
+#endif
+
+// columns (in pixels) of one page touched by the last render()
+struct termWindow {
+    uint8_t page;
+    uint8_t col0;
+    uint8_t col1;
+};
+
+class puroPixel_Terminal {
+public:
+    puroPixel_Terminal(puroPixel_SSD1306* display);
+    void clear();
+    void setCursor(uint8_t col, uint8_t row);
+    uint8_t getCursorX();
+    uint8_t getCursorY();
+    void setInverse(bool inverse);
+    void write(char character);
+    void print(const char* text);
+    void printf(const char* format, ...);
+    void putAt(uint8_t col, uint8_t row, const char* text);
+    uint16_t render();
+    uint8_t getWindows(termWindow* out, uint8_t max);
+    void update();
+    void invalidate();
+    uint8_t getCols();
+    uint8_t getRows();
+private:
+    puroPixel_SSD1306* display;
+    uint8_t cols, rows;
+    uint8_t cursorX = 0, cursorY = 0;
+    bool inverse = false;
+    // wanted and on-screen content, bit 7 of a cell is the inverse flag (the font stops at 0x7F)
+    char cells[SSD1306_TERMINAL_ROWS][SSD1306_TERMINAL_COLS];
+    char shown[SSD1306_TERMINAL_ROWS][SSD1306_TERMINAL_COLS];
+    uint8_t windowLo[SSD1306_TERMINAL_ROWS]; // last render() windows, in cells, lo > hi when the row didn't change
+    uint8_t windowHi[SSD1306_TERMINAL_ROWS];
+    void scroll();
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "ticker.h"
+#include "font.h"
+
+/*!
+@brief creates a ticker on a band of pages. The band is the only thing it touches, draw the rest of the screen as usual.
+@param display
+    the display.
+@param page0
+    first page of the band (row / 8).
+@param pages
+    how many pages tall the band is, 1 fits scale 1 text, 2 fits scale 2.
+*/
+puroPixel_Ticker::puroPixel_Ticker(puroPixel_SSD1306* d, uint8_t p0, uint8_t count) {
+    display = d;
+    page0 = p0;
+    pages = count ? count : 1;
+    if (pages > SSD1306_MAX_PAGES) pages = SSD1306_MAX_PAGES;
+}
+
+/*!
+@brief sets the text, it comes in from the right edge and repeats forever.
+@param text
+    the text, it's not copied so keep it alive (a literal or a global is fine).
+@param scale
+    text size, 1 to 4.
+@param gap
+    empty columns between the end of the text and its next repetition.
+*/
+void puroPixel_Ticker::setText(const char* t, uint8_t s, uint8_t g) {
+    text = t;
+    textLength = t ? strlen(t) : 0;
+    scale = s < 1 ? 1 : (s > 4 ? 4 : s);
+    gap = g;
+    offset = 0;
+}
+
+/*!
+@brief minimum time between two steps, in milliseconds. Default is 25, much faster and the panel starts dropping steps.
+*/
+void puroPixel_Ticker::setInterval(uint16_t ms) {
+    interval = ms;
+}
+
+/*!
+@brief 1 = lit text on a dark band (default), 0 = dark text on a lit band.
+*/
+void puroPixel_Ticker::setColor(uint16_t c) {
+    color = c;
+}
+
+/*!
+@brief call it from your loop(), it moves the text one column once the interval is up.
+@return true if it moved.
+*/
+bool puroPixel_Ticker::step() {
+    if ((uint32_t)(millis() - lastStep) < interval) return false;
+    stepNow();
+    return true;
+}
+
+/*!
+@brief moves the text one column right now, no matter the interval.
+*/
+void puroPixel_Ticker::stepNow() {
+    uint8_t in[SSD1306_MAX_PAGES];
+    column(offset, in);
+    display->scrollContent(page0, page0 + pages - 1, in);
+    lastStep = millis();
+
+    uint16_t period = textLength * 6 * scale + gap;
+    offset = period ? (offset + 1) % period : 0;
+}
+
+/*!
+@brief which column of the text (gap included) comes in with the next step.
+*/
+uint16_t puroPixel_Ticker::getOffset() {
+    return offset;
+}
+
+// one band column of the text, x counts from the first column of the first character
+void puroPixel_Ticker::column(uint16_t x, uint8_t* out) {
+    uint32_t bits = 0;
+    uint16_t charWidth = 6 * scale;
+    if (x < textLength * charWidth) {
+        uint8_t character = text[x / charWidth]; // unsigned, so the range test below sees 0x80 and up
+        uint8_t cx = (x % charWidth) / scale;
+        if (cx < 5 && character >= 0x20 && character <= 0x7F) {
+            uint8_t font = ASCII[character - 0x20][cx] & 0x7F;
+            uint32_t block = (1UL << scale) - 1;
+            for (uint8_t j = 0; j < 7; j++) {
+                if ((font >> j) & 1) bits |= block << (j * scale);
+            }
+        }
+    }
+    for (uint8_t p = 0; p < pages; p++) {
+        uint8_t b = p < 4 ? (bits >> (p * 8)) & 0xFF : 0;
+        out[p] = color == 1 ? b : ~b;
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef SSD1306_TICKER_H__
+#define SSD1306_TICKER_H__
+
+#include "ssd1306.h"
+
+// Scrolling text on a band of pages. Every step moves the band one column with the panel's own content scroll
+// and sends just the column that comes in (1 byte per page), instead of redrawing and resending the band.
+class puroPixel_Ticker {
+public:
+    puroPixel_Ticker(puroPixel_SSD1306* display, uint8_t page0, uint8_t pages = 1);
+    void setText(const char* text, uint8_t scale = 1, uint8_t gap = 16);
+    void setInterval(uint16_t ms);
+    void setColor(uint16_t color);
+    bool step();
+    void stepNow();
+    uint16_t getOffset();
+private:
+    puroPixel_SSD1306* display;
+    uint8_t page0, pages;
+    const char* text = nullptr;
+    uint16_t textLength = 0;
+    uint8_t scale = 1;
+    uint8_t gap = 16;
+    uint16_t color = 1;
+    uint16_t interval = 25; // the panel wants ~2 frames between content scroll steps
+    uint32_t lastStep = 0;
+    uint16_t offset = 0; // next text column to bring in
+    void column(uint16_t x, uint8_t* out);
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "transport.h"
+#include "ssd1306.h"
+#include <SPI.h>
+
+/*!
+@brief the I2C transport the TwoWire constructor of the display uses, only needed on its own to share it or wrap it.
+@param i2c
+    wire pointer. Defines as: &Wire
+@param addr
+    adress of your SSD1306, usually is 0x3C.
+*/
+puroPixel_I2CTransport::puroPixel_I2CTransport(TwoWire* i2c, uint8_t addr) {
+    wire = i2c;
+    address = addr;
+}
+
+// Co = 0 stream: every byte after the control byte is a command (0x00) or GDDRAM data (0x40), so a whole
+// list goes in one transaction, split only when it doesn't fit the TX buffer
+void puroPixel_I2CTransport::send(uint8_t control, const uint8_t* bytes, uint16_t len) {
+    if (wire == nullptr) return; // default constructed, there is no bus to send to
+    while (len > 0) {
+        uint16_t chunk = len < (SSD1306_WIRE_MAX - 1) ? len : (SSD1306_WIRE_MAX - 1);
+        wire->beginTransmission(address);
+        wire->write(control);
+        wire->write(bytes, chunk);
+        wire->endTransmission();
+        this->bytes += chunk + 1;
+        transactions++;
+        bytes += chunk;
+        len -= chunk;
+    }
+}
+
+void puroPixel_I2CTransport::commands(const uint8_t* cmds, uint16_t len) {
+    send(SSD1306_CONTROL_COMMAND, cmds, len);
+}
+
+void puroPixel_I2CTransport::data(const uint8_t* bytes, uint16_t len) {
+    send(SSD1306_CONTROL_DATA, bytes, len);
+}
+
+// one control byte per burst of send()
+uint16_t puroPixel_I2CTransport::overhead(uint16_t len) {
+    return (len + SSD1306_WIRE_MAX - 2) / (SSD1306_WIRE_MAX - 1);
+}
+
+bool puroPixel_I2CTransport::probe() {
+    if (wire == nullptr) return false;
+    wire->beginTransmission(address);
+    transactions++;
+    return wire->endTransmission() == 0; // 0 = ACK
+}
+
+/*!
+@brief a transport for SSD1306 modules wired for 4-wire SPI (D/C pin instead of the I2C control byte). Call SPI.begin() (with your pins) first.
+@param spi
+    the SPI bus. Defines as: &SPI
+@param dc
+    data/command pin.
+@param cs
+    chip select pin, -1 if CS is tied low.
+@param rst
+    reset pin, -1 if it isn't connected. begin() pulses it.
+@param frequency
+    SPI clock, 8 MHz by default.
+*/
+puroPixel_SPITransport::puroPixel_SPITransport(SPIClass* bus, int8_t dc, int8_t cs, int8_t rst, uint32_t freq) {
+    spi = bus;
+    dcPin = dc;
+    csPin = cs;
+    rstPin = rst;
+    frequency = freq;
+}
+
+bool puroPixel_SPITransport::begin() {
+    pinMode(dcPin, OUTPUT);
+    if (csPin >= 0) {
+        pinMode(csPin, OUTPUT);
+        digitalWrite(csPin, HIGH);
+    }
+    if (rstPin >= 0) {
+        // the controller wants RES# low for at least 3 us after power up
+        pinMode(rstPin, OUTPUT);
+        digitalWrite(rstPin, HIGH);
+        delay(1);
+        digitalWrite(rstPin, LOW);
+        delay(10);
+        digitalWrite(rstPin, HIGH);
+        delay(1);
+    }
+    return true;
+}
+
+void puroPixel_SPITransport::send(bool isData, const uint8_t* bytes, uint16_t len) {
+    if (len == 0) return;
+    spi->beginTransaction(SPISettings(frequency, MSBFIRST, SPI_MODE0));
+    digitalWrite(dcPin, isData ? HIGH : LOW);
+    if (csPin >= 0) digitalWrite(csPin, LOW);
+#if defined(ESP32)
+    spi->writeBytes(bytes, len); // whole FIFO loads instead of one byte at a time
+#else
+    for (uint16_t i = 0; i < len; i++) spi->transfer(bytes[i]);
+#endif
+    if (csPin >= 0) digitalWrite(csPin, HIGH);
+    spi->endTransaction();
+    this->bytes += len;
+    transactions++;
+}
+
+void puroPixel_SPITransport::commands(const uint8_t* cmds, uint16_t len) {
+    send(false, cmds, len);
+}
+
+void puroPixel_SPITransport::data(const uint8_t* bytes, uint16_t len) {
+    send(true, bytes, len);
+}
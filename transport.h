@@ -0,0 +1,64 @@
+#ifndef SSD1306_TRANSPORT_H__
+#define SSD1306_TRANSPORT_H__
+
+#include "wire.h"
+#include "Arduino.h"
+
+// How the bytes get to the panel. The display only ever sends "these are commands" or "this is GDDRAM data",
+// the transport decides what that means on the wire: a control byte in front (I2C) or the D/C pin (4-wire SPI).
+// Write your own for other buses, or a recording one for tests (examples/host/mocktransport.h).
+
+class SPIClass;
+
+class puroPixel_Transport {
+public:
+    virtual ~puroPixel_Transport() {}
+    virtual bool begin() { return true; }  // pins, reset pulse... called by the display's begin() before the init commands
+    virtual void commands(const uint8_t* cmds, uint16_t len) = 0;
+    virtual void data(const uint8_t* bytes, uint16_t len) = 0;
+    virtual bool probe() { return true; }  // is a panel answering?
+    // transports that hand data() to DMA may return before the bytes are out, the display calls wait()
+    // before it touches what it sent (end of update(), async frame done)
+    virtual bool isBusy() { return false; }
+    virtual void wait() {}
+    // bytes a commands()/data() call of len bytes adds on the bus (control bytes...), flushStep() budgets with it
+    virtual uint16_t overhead(uint16_t len) { (void)len; return 0; }
+
+    uint32_t getBytes() { return bytes; }              // bytes put on the bus, control bytes included
+    uint32_t getTransactions() { return transactions; } // I2C transactions / SPI chip selects
+protected:
+    uint32_t bytes = 0;
+    uint32_t transactions = 0;
+};
+
+// I2C: a 0x00 (commands) or 0x40 (data) control byte in front, split in bursts of the TwoWire TX buffer
+class puroPixel_I2CTransport : public puroPixel_Transport {
+public:
+    puroPixel_I2CTransport(TwoWire* i2c = nullptr, uint8_t addr = 0x3C);
+    void commands(const uint8_t* cmds, uint16_t len);
+    void data(const uint8_t* bytes, uint16_t len);
+    bool probe();
+    uint16_t overhead(uint16_t len);
+    bool hasWire() { return wire != nullptr; }
+private:
+    TwoWire* wire;
+    uint8_t address;
+    void send(uint8_t control, const uint8_t* bytes, uint16_t len);
+};
+
+// 4-wire SPI: D/C low for commands, high for data, CS around every transfer. Set it up with the
+// same frequency your module takes (SSD1306: 10 MHz at most).
+class puroPixel_SPITransport : public puroPixel_Transport {
+public:
+    puroPixel_SPITransport(SPIClass* spi, int8_t dc, int8_t cs = -1, int8_t rst = -1, uint32_t frequency = 8000000);
+    bool begin();
+    void commands(const uint8_t* cmds, uint16_t len);
+    void data(const uint8_t* bytes, uint16_t len);
+private:
+    SPIClass* spi;
+    int8_t dcPin, csPin, rstPin;
+    uint32_t frequency;
+    void send(bool isData, const uint8_t* bytes, uint16_t len);
+};
+
+#endif